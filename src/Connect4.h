@@ -4,27 +4,141 @@
 #include "Connect4Board.h"
 #include "Connect4AI.h"
 
-class Connect4 {
+// Game on a Rows x Cols board where Win stones in a row win; Connect4 is
+// the standard 6x7, connect 4 game. Columns are numbered from 1 to Cols.
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+class BasicConnect4 {
+public:
+    typedef BasicConnect4Board<Rows, Cols, Win> Board;
+    typedef BasicConnect4AI<Rows, Cols, Win> AI;
+
 private:
-    Connect4Board board;
-    Connect4AI ai;  // Used for calculateBestMove
+    Board board;
+    AI ai;  // Used for calculateBestMove
+    
+#if CONNECT4_THREADS
+    typedef BasicConnect4BitBoard<Rows, Cols, Win> BitBoard;
+    
+    // Pondering (see setAIPondering)
+    enum class PonderState : uint8_t {
+        IDLE,       // No background search
+        WAITING,    // Searching, the expected reply not played yet
+        HIT         // Searching, and the expected reply was played
+    };
+    
+    AI ponderAI;                    // Copy of ai searching on the thread
+    BitBoard ponderBoard;           // Position after the expected reply...
+    Player ponderPlayer;            // ...searched for this player...
+    uint8_t ponderDepth;            // ...to this depth (0: timed, until stopped)
+    int8_t ponderReply;             // Expected reply (0-based)
+    int8_t ponderMove;              // Result, read once the thread is joined
+    std::chrono::steady_clock::time_point ponderStart;  // Search start, for timed hits
+    PonderState ponderState;
+    bool ponderEnabled;
+    uint32_t ponderHits;
+    std::atomic<bool> ponderStop;
+    std::atomic<bool> ponderDone;
+    std::thread ponderThread;
+    
+    // Last move returned by the AI, pondered on once it is played
+    int8_t lastAIMove;
+    Player lastAIPlayer;
+    uint8_t lastAIDepth;            // 0 for a timed search
+    
+    // Search the position after the expected reply to the AI's move
+    void startPondering();
     
-    // Internal method using 0-6 indexing
+    // Stop and join the background search; its result is dropped
+    void stopPondering();
+    
+    // Track a move played on the board: start, keep or drop the ponder search
+    void updatePondering(uint8_t column, Player player);
+    
+    // Move of the ponder search if it is searching this position for
+    // player (waiting up to maxMillis for a timed one), -1 otherwise
+    int8_t takePonderMove(Player player, uint8_t depth, uint32_t maxMillis);
+    
+    // Remember the AI's move for pondering
+    void recordAIMove(int8_t move, Player player, uint8_t depth);
+#endif
+    
+    // Internal method using 0-based indexing
     bool playMoveInternal(uint8_t column, Player player);
+    
+    // Horizontal line above and below the board
+    void printRule() const;
 
 public:
     // Constructor
-    Connect4();
+    BasicConnect4();
+#if CONNECT4_THREADS
+    // A copy gets the board and settings, not the background search
+    BasicConnect4(const BasicConnect4& other);
+    BasicConnect4& operator=(const BasicConnect4& other);
+    ~BasicConnect4();
+#endif
 
     // Game control methods
     void reset();
-    bool playMove(uint8_t column, Player player);  // User-facing: column 1-7
+    bool playMove(uint8_t column, Player player);  // User-facing: column 1-Cols
     
-    // AI calculation method (returns 1-7, or 0 if no valid move)
+    // AI calculation method (returns 1-Cols, or 0 if no valid move)
     uint8_t calculateBestMove(Player player, uint8_t depth);
     
+    // Same as above, searching as deep as possible within maxMillis
+    uint8_t calculateBestMoveTimed(Player player, uint32_t maxMillis);
+    
+    // Score of every column for player in one search (see
+    // Connect4AI::analyzeMoves): scores[column - 1] is the score of playing
+    // column, Connect4AI::NO_SCORE for a full column. With lines, line column - 1
+    // (lines[(column - 1) * lineLength]) receives column and the replies
+    // expected after it (1-Cols), padded with 0.
+    // Returns the best column (1-Cols), or 0 if the game is over
+    uint8_t analyzeMoves(Player player, uint8_t depth, int32_t scores[Cols],
+                         uint8_t* lines = nullptr, uint8_t lineLength = 0);
+    
+    // Number of AI search threads (ignored on Arduino; see
+    // Connect4AI::setThreads for how results differ with several)
+    void setAIThreads(uint8_t count);
+    
+    // Alpha-beta variant used by the AI (SearchAlgorithm::MINIMAX by default)
+    void setAIAlgorithm(SearchAlgorithm algorithm);
+    
+    // Solve positions exactly instead of searching to a depth (see
+    // Connect4AI::setPerfectPlay)
+    void setAIPerfectPlay(bool enabled);
+    
+    // Weights of the AI's evaluation (see Connect4AI::setEvalWeights)
+    void setAIEvalWeights(const Connect4EvalWeights& weights);
+    
+    // Aspiration windows and late move reductions of the AI's search (see
+    // Connect4AI::setAspirationWindow and setLateMoveReductions)
+    void setAIAspirationWindow(int32_t window);
+    void setAILateMoveReductions(bool enabled);
+    
+    // Opening book answering the first moves instantly (nullptr to disable)
+    void setOpeningBook(const Connect4OpeningBook* book);
+    
+    // Think on the opponent's time. Once the AI's move is played, the AI
+    // searches the position after the reply it expects on a background
+    // thread; if that reply is played, the next calculateBestMove() with
+    // the same depth returns the result at once, or as soon as the search
+    // ends (calculateBestMoveTimed() counts the time already pondered in
+    // its budget: it keeps the search going for the rest, or returns at once
+    // if the budget is used up). Any other move, reset() or a change of
+    // AI setting stops the search; analyzeMoves() runs beside it, on the
+    // same table.
+    // Ignored without CONNECT4_THREADS (Arduino).
+    void setAIPondering(bool enabled);
+    
+    // Moves answered by a ponder search since the game was created
+    uint32_t getPonderHits() const;
+    
+    // Reply the AI expects to its last move (1-Cols), 0 if unknown
+    uint8_t getExpectedReply() const;
+    
     // Game state queries
-    bool isValidMove(uint8_t column) const;  // Takes column 1-7
+    bool isValidMove(uint8_t column) const;  // Takes column 1-Cols
     bool hasWinner() const;
     Player getWinner() const;
     bool isDraw() const;
@@ -32,7 +146,7 @@ public:
     GameState getGameState() const;
     
     // Board access
-    const Connect4Board& getBoard() const;
+    const Board& getBoard() const;
     Player getCell(uint8_t row, uint8_t col) const;
     uint8_t getColumnHeight(uint8_t col) const;
     
@@ -41,4 +155,10 @@ public:
     void printBoard() const;
 };
 
+#include "Connect4Impl.h"
+
+// The standard game is compiled once, in Connect4.cpp
+extern template class BasicConnect4<>;
+typedef BasicConnect4<> Connect4;
+
 #endif // CONNECT4_H
@@ -2,32 +2,456 @@
 #define CONNECT4_AI_H
 
 #include "Connect4Board.h"
+#include "Connect4BitBoard.h"
+#include "Connect4TranspositionTable.h"
+#include "Connect4Evaluator.h"
+#include "Connect4OpeningBook.h"
+#include "Connect4SearchStats.h"
 #include <stdint.h>
 
-class Connect4AI {
+// Deepest search below the root, in plies: the search recursion, its stack
+// use and the per-ply tables (killer moves, principal variation) are
+// bounded by it. Deeper searches are cut to this depth, and positions with
+// more empty cells are not solved (see Connect4AI::setPerfectPlay).
+// Unbounded by default except on AVR, e.g. -DCONNECT4_MAX_PLY=24.
+#ifndef CONNECT4_MAX_PLY
+#if defined(__AVR__)
+#define CONNECT4_MAX_PLY 16
+#else
+#define CONNECT4_MAX_PLY 64
+#endif
+#endif
+
+// Alpha-beta variant used by Connect4AI (see setSearchAlgorithm)
+enum class SearchAlgorithm : uint8_t {
+    MINIMAX,    // Plain alpha-beta with a full window at every node
+    PVS,        // Principal Variation Search: null windows after the first move
+    MTDF        // MTD(f): null-window searches converging on the root score
+};
+
+// Exact value of a position (see Connect4AI::solve)
+struct Connect4Solution {
+    int8_t score;       // > 0: the side to move wins, < 0: it loses, 0: draw;
+                        // the sooner the game ends, the larger |score|
+    uint8_t distance;   // Plies until the game ends with perfect play
+    int8_t bestMove;    // Column 0-6, or -1 if the game is over
+};
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+class BasicConnect4Search;
+
+// Search engine for a Rows x Cols board where Win stones in a row win
+// (Connect4AI is the standard 6x7, connect 4 instantiation)
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+class BasicConnect4AI {
+    // The resumable search shares the table conventions and move order
+    friend class BasicConnect4Search<Rows, Cols, Win>;
+
+public:
+    typedef BasicConnect4Board<Rows, Cols, Win> Board;
+    typedef BasicConnect4BitBoard<Rows, Cols, Win> BitBoard;
+    typedef typename BitBoard::Bits Bits;
+    typedef BasicConnect4Evaluator<Rows, Cols, Win> Evaluator;
+
+    static constexpr uint8_t CELLS = Rows * Cols;
+
+    // Maximum search depth (CONNECT4_MAX_PLY, at most the board size)
+    static constexpr uint8_t MAX_PLY = CONNECT4_MAX_PLY < CELLS ? CONNECT4_MAX_PLY : CELLS;
+
+    // Score of a full column in analyzeMoves
+    static constexpr int32_t NO_SCORE = INT32_MIN;
+
 private:
-    // Evaluation constants
-    static constexpr int32_t WIN_SCORE = 100000;
-    static constexpr int32_t THREE_SCORE = 100;
-    static constexpr int32_t TWO_SCORE = 10;
-    static constexpr int32_t CENTER_SCORE = 3;
-
-    // Evaluate a window of 4 cells
-    int32_t evaluateWindow(Player p1, Player p2, Player p3, Player p4, Player player) const;
-    
-    // Evaluate the entire board position
-    int32_t evaluateBoard(const Connect4Board& board, Player player) const;
+    static constexpr int32_t WIN_SCORE = Evaluator::WIN_SCORE;
+
+    // Evaluation of the searched position, updated on every move
+    Evaluator evaluator;
+
+    // Transposition table shared by searches (nullptr disables it)
+    Connect4TranspositionTable* table;
+
+    // Opening book consulted before searching (nullptr disables it)
+    const Connect4OpeningBook* book;
+
+    // Time budget of the current search (see calculateBestMoveTimed)
+    uint32_t searchStart;
+    uint32_t searchBudget;
+    uint64_t nodeCount;     // Nodes visited by the last search
+    uint8_t rootMoveCount;  // Stones on the board at the root
+    int32_t lastScore;      // Score of the last best move
+    uint64_t weightsKey;    // keyOfWeights of the evaluator's weights
+#if CONNECT4_SEARCH_STATS
+    SearchStats stats;      // Counters of the last search
+#endif
+    bool hasDeadline;
+    bool aborted;
+
+    // Number of search threads (see setThreads)
+    uint8_t threadCount;
+    SearchAlgorithm algorithm;
+    bool perfectPlay;       // Solve instead of searching (see setPerfectPlay)
+    int32_t aspirationWindow;   // 0: full root windows (see setAspirationWindow)
+    bool lateMoveReductions;    // See setLateMoveReductions
+#if CONNECT4_SEARCH_STATS
+    uintptr_t stackBase;    // Stack address at the start of the search
+#endif
+#if CONNECT4_THREADS
+    const std::atomic<bool>* stopFlag;  // Set by the main thread to stop helpers
+#endif
+
+    static uint32_t nowMillis();
+
+    // True when the deadline has passed or the search was stopped
+    bool shouldStop() const;
+
+    // True if the solver's recursion (one ply per empty cell) fits MAX_PLY
+    static bool canSolve(const BitBoard& board) {
+        return CELLS - board.getMoveCount() <= MAX_PLY;
+    }
+
+#if CONNECT4_SEARCH_STATS
+    // Record the stack use at a search node, given the address of a local
+    void noteStack(const void* local) {
+        uintptr_t here = reinterpret_cast<uintptr_t>(local);
+        if (here < stackBase && stackBase - here > stats.stackBytes) {
+            stats.stackBytes = static_cast<uint32_t>(stackBase - here);
+        }
+    }
+#endif
+
+    // Late move reductions: from this move of a node, at this remaining depth
+    static constexpr uint8_t LMR_FULL_MOVES = 3;
+    static constexpr uint8_t LMR_MIN_DEPTH = 3;
+
+    // True if the searched-th move of a node, col, is searched a ply
+    // shallower first: a late move that makes no new threat for player
+    bool reduces(const BitBoard& board, Player player, uint8_t col, uint8_t searched, uint8_t depth) const {
+        return lateMoveReductions && searched > LMR_FULL_MOVES && depth >= LMR_MIN_DEPTH &&
+               BitBoard::popCount(board.getWinningCellsAfter(player, col)) <=
+                   BitBoard::popCount(board.getWinningCells(player));
+    }
+
+    // Move ordering heuristics, reset for every search
+    static constexpr uint8_t NO_MOVE = 0xFF;
+    uint8_t killers[MAX_PLY][2];                     // Last cutoff moves per ply
+    uint16_t history[2][CELLS];                      // Cutoff score per player and cell
+
+    // Principal variation of the last search: its move, then the line the
+    // table expects (kept until the next search)
+    int8_t pv[MAX_PLY];
+    uint8_t pvLength;
+
+    // Flags folded into table keys: spare bits above the position key, or
+    // distinct constants mixed in on boards whose keys use those bits
+    // (collisions then become possible, if very unlikely)
+    static constexpr uint64_t keyFlag(uint8_t n) {
+        return BitBoard::KEY_BITS <= 60 ? UINT64_C(1) << (63 - n)
+                                        : UINT64_C(0x9E3779B97F4A7C15) * (2 * n + 1);
+    }
+
+    // Table depth of solver entries: exact whatever the depth, so search
+    // entries of the same search (at most MAX_PLY deep) never replace them,
+    // while solver entries replace each other (the most recent prune best)
+    static constexpr uint8_t SOLVER_DEPTH = UINT8_MAX;
+
+    // Table key of a position for the given side to move and AI player
+    // (the same for a position and its mirror image), mixed with the key of
+    // the evaluation weights that score it
+    static uint64_t tableKey(const BitBoard& board, bool maximizing, Player aiPlayer, uint64_t weightsKey);
+
+    // Mixed into the table keys of searches with these weights, so that
+    // searches with other weights never read their entries: 0 for the
+    // default weights, a hash of the weights otherwise
+    static uint64_t keyOfWeights(const Connect4EvalWeights& weights);
+
+    // Convert a move between the board and the orientation of its table key
+    // (either way: mirroring is its own inverse)
+    static int8_t tableMove(const BitBoard& board, int8_t move) {
+        return (move >= 0 && board.isMirrored()) ? BitBoard::mirrorColumn(move) : move;
+    }
+
+    // Table move of the position (search or solver entry), -1 if unknown
+    int8_t probeMove(const BitBoard& board, bool maximizing, Player aiPlayer, bool solver) const;
+
+    // Copy move and the replies found in the table after it into line
+    // (at most maxLength moves); returns the length of the line
+    uint8_t tableLine(const BitBoard& board, Player player, int8_t move, bool solver,
+                      int8_t* line, uint8_t maxLength) const;
+
+    // Fill pv with move and the replies found in the table after it
+    void recordPV(const BitBoard& board, Player player, int8_t move, bool solver) {
+        pvLength = tableLine(board, player, move, solver, pv, MAX_PLY);
+    }
+
+    // Fill moveOrder with firstMove (if valid) followed by center-out columns
+    static void orderMoves(int8_t firstMove, uint8_t moveOrder[Cols]);
+
+    // Reset per-search counters and flags
+    void beginSearch(const BitBoard& board);
+
+    // Book move for player, or -1 if the position is not in the book
+    int8_t bookMove(const BitBoard& board, Player player) const;
+
+    // Exact score for player to move from a solved book, if it holds the
+    // position
+    bool bookScore(const BitBoard& board, Player player, int32_t& score) const;
+
+    // Make / undo a move on the searched board and keep the evaluator in sync
+    void play(BitBoard& board, uint8_t col, Player player);
+    void unplay(BitBoard& board, uint8_t col);
     
+    // Fill moveOrder for a search node: table move, killers, then history
+    void orderNodeMoves(const BitBoard& board, uint8_t ply, Player player,
+                        int8_t ttMove, uint8_t moveOrder[Cols]) const;
+
+    // Update killers and history after col caused a cutoff (board after undo)
+    void recordCutoff(const BitBoard& board, uint8_t ply, Player player,
+                      uint8_t col, uint8_t depth);
+
     // Minimax with alpha-beta pruning
-    int32_t minimax(Connect4Board& board, uint8_t depth, int32_t alpha, int32_t beta, 
-                   bool maximizing, Player aiPlayer) const;
+    int32_t minimax(BitBoard& board, uint8_t depth, int32_t alpha, int32_t beta, 
+                   bool maximizing, Player aiPlayer);
+
+    // Negamax PVS: same pruning and table as minimax, but scores are from
+    // the side to move's point of view and only the first move of a node
+    // gets the full window (table entries stay in aiPlayer's point of view)
+    int32_t negamax(BitBoard& board, uint8_t depth, int32_t alpha, int32_t beta,
+                    bool maximizing, Player aiPlayer);
+
+    // MTD(f) from guess at the root; returns the table move, or -1 if unknown
+    int8_t searchMTDF(BitBoard& board, Player player, uint8_t depth,
+                      int32_t guess, int32_t& bestScore);
+
+    // Exact solver: negamax over game-theoretic scores ((CELLS + 2 - m) / 2
+    // for a win with the m-th stone of the game, negated for a loss). The
+    // side to move must not be able to win immediately.
+    int32_t solveNegamax(BitBoard& board, Player player, int32_t alpha, int32_t beta);
+
+    // Exact score by null-window searches narrowing [min, max]; bestMove
+    // receives a move reaching it, or -1 if that needs another search
+    int32_t solveScore(BitBoard& board, Player player, int8_t& bestMove);
+
+    // Fill order with the moves in mask, most winning cells created first
+    static uint8_t orderSolverMoves(const BitBoard& board, Player player, Bits mask,
+                                    uint8_t order[Cols]);
+
+    // Solver score in getLastScore() units
+    static int32_t solutionScore(const Connect4Solution& solution);
+
+    // Solve the position and pick a move reaching its score
+    void solveRoot(BitBoard& board, Player player, Connect4Solution& solution);
+
+    // Exact score of playing col: searched with a full window to depth, or
+    // solved (in getLastScore() units)
+    int32_t scoreMove(BitBoard& board, Player player, uint8_t col, uint8_t depth, bool solver);
+
+    // Search all root moves within (alpha, beta), trying firstMove first;
+    // bestScore receives the best score, only a bound if it falls outside
+    // the window (the search stops at the first move reaching beta)
+    int8_t searchRoot(BitBoard& board, Player player, uint8_t depth, int8_t firstMove, int32_t& bestScore,
+                      int32_t alpha = -INT32_MAX, int32_t beta = INT32_MAX);
+
+    // searchRoot within the aspiration window around lastScore, widened
+    // until the score falls inside it
+    int8_t searchAspiration(BitBoard& board, Player player, uint8_t depth, int8_t firstMove, int32_t& score);
+
+    // Iterative deepening up to maxDepth, optionally bounded by the time budget
+    int8_t deepen(BitBoard& board, Player player, uint8_t maxDepth, bool timed);
+
+    // Lazy SMP helper thread body: deepens until stopped, filling the table
+    void helperSearch(BitBoard& board, Player player, uint8_t maxDepth, uint8_t helperIndex);
+
+    // Run deepen() on this thread alongside threadCount - 1 helpers
+    int8_t searchThreads(BitBoard& board, Player player, uint8_t maxDepth, bool timed);
 
 public:
-    Connect4AI() = default;
+    BasicConnect4AI()
+        : table(&Connect4TranspositionTable::shared()), book(nullptr),
+          searchStart(0), searchBudget(0), nodeCount(0), rootMoveCount(0), lastScore(0), weightsKey(0), hasDeadline(false), aborted(false),
+          threadCount(1), algorithm(SearchAlgorithm::MINIMAX),
+          perfectPlay(false), aspirationWindow(0), lateMoveReductions(false)
+#if CONNECT4_THREADS
+          , stopFlag(nullptr)
+#endif
+          , pvLength(0) {}
+
+    // Use another transposition table, or nullptr to search without one
+    void setTranspositionTable(Connect4TranspositionTable* newTable) {
+        table = newTable;
+    }
+
+    Connect4TranspositionTable* getTranspositionTable() const {
+        return table;
+    }
+
+    // Answer book positions without searching (nullptr disables the book).
+    // The solver also takes the scores of a solved book.
+    void setOpeningBook(const Connect4OpeningBook* newBook) {
+        book = newBook;
+    }
+
+    // Search with several threads sharing the transposition table (Lazy SMP).
+    // With more than one thread, calculateBestMove deepens iteratively up to
+    // its depth (the helpers feed the table with the shallower iterations),
+    // so node counts and the choice between equally scored moves differ
+    // from a single-thread search, and may vary from run to run.
+    // Builds without CONNECT4_THREADS (Arduino) always search on one thread.
+    void setThreads(uint8_t count) {
+#if CONNECT4_THREADS
+        threadCount = count > 0 ? count : 1;
+#else
+        (void)count;
+        threadCount = 1;
+#endif
+    }
+
+    uint8_t getThreads() const {
+        return threadCount;
+    }
+
+    // Choose the alpha-beta variant. PVS and MTD(f) find the same root score
+    // as minimax while visiting fewer nodes; MTD(f) needs the transposition
+    // table and falls back to PVS without one.
+    void setSearchAlgorithm(SearchAlgorithm newAlgorithm) {
+        algorithm = newAlgorithm;
+    }
+
+    SearchAlgorithm getSearchAlgorithm() const {
+        return algorithm;
+    }
+
+    // Play perfectly: calculateBestMove solves the position exactly and
+    // ignores the depth; calculateBestMoveTimed tries to solve within half
+    // of the budget and searches normally with the rest if it cannot.
+    // Solving early positions takes a long time: use a large table.
+    // Positions with more than MAX_PLY empty cells are searched instead.
+    void setPerfectPlay(bool enabled) {
+        perfectPlay = enabled;
+    }
+
+    bool getPerfectPlay() const {
+        return perfectPlay;
+    }
+
+    // Aspiration windows: each iteration of a deepening search first
+    // searches the root within +/-window of the previous iteration's score,
+    // and again with a wider window if the score falls outside. With a
+    // window, calculateBestMove deepens to its depth to get those scores.
+    // 0 (the default) searches full windows; MTD(f) ignores it.
+    void setAspirationWindow(int32_t window) {
+        aspirationWindow = window > 0 ? window : 0;
+    }
+
+    int32_t getAspirationWindow() const {
+        return aspirationWindow;
+    }
+
+    // Late move reductions: the moves of a node ordered after the table
+    // move and killers are searched a ply shallower first, and again at
+    // full depth only if they look better than the best move so far.
+    // Deeper searches in the same time, but scores are no longer exact.
+    void setLateMoveReductions(bool enabled) {
+        lateMoveReductions = enabled;
+    }
+
+    bool getLateMoveReductions() const {
+        return lateMoveReductions;
+    }
+
+    // Weights of the heuristic evaluation (see Connect4EvalWeights), used
+    // from the next search. Table entries are keyed by the weights that
+    // scored them, so AIs with different weights can share a table.
+    void setEvalWeights(const Connect4EvalWeights& weights) {
+        evaluator.setWeights(weights);
+        weightsKey = keyOfWeights(weights);
+    }
+
+    const Connect4EvalWeights& getEvalWeights() const {
+        return evaluator.getWeights();
+    }
+
+    // Exact win/draw/loss value of the position for player, to move, with
+    // the distance to the end of the game and a best move (bestMove is -1
+    // if the game is over or the position has more than MAX_PLY empty cells).
+    // Early positions take long to solve: use a large table, or a solved
+    // opening book (see setOpeningBook) that ends the searches at its ply.
+    Connect4Solution solve(Board& board, Player player);
+    Connect4Solution solve(BitBoard& board, Player player);
+
+    // Nodes visited by the last search (all threads)
+    uint64_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    // Score of the last best move from the searching player's point of view
+    // (beyond +/-Connect4Evaluator::WIN_SCORE: forced win/loss, 0 for book moves)
+    int32_t getLastScore() const {
+        return lastScore;
+    }
+
+    // Line expected by the last search: its move, the opponent's expected
+    // reply, and so on as far as the table knows it. Copies up to maxMoves
+    // columns (0-6) into moves and returns how many were copied.
+    uint8_t getPrincipalVariation(int8_t* moves, uint8_t maxMoves) const;
+
+    // Opponent's reply expected after the last move returned, -1 if unknown
+    int8_t getExpectedReply() const {
+        return pvLength >= 2 ? pv[1] : -1;
+    }
+
+#if CONNECT4_THREADS
+    // Flag another thread sets to stop the searches of this AI early
+    // (nullptr for none): a timed search then returns the move of its
+    // deepest completed iteration, a fixed-depth one an unreliable move
+    void setStopFlag(const std::atomic<bool>* flag) {
+        stopFlag = flag;
+    }
+#endif
+
+    // Statistics of the last search (all zero without CONNECT4_SEARCH_STATS)
+    const SearchStats& getSearchStats() const {
+#if CONNECT4_SEARCH_STATS
+        return stats;
+#else
+        static const SearchStats none;
+        return none;
+#endif
+    }
 
     // Calculate the best move for the given player at specified depth
+    // (at most MAX_PLY)
+    // Returns the column number (0-6) or -1 if no valid move
+    int8_t calculateBestMove(Board& board, Player player, uint8_t depth);
+
+    // Same as above, searching directly on a bitboard
+    int8_t calculateBestMove(BitBoard& board, Player player, uint8_t depth);
+
+    // Iterative deepening within a time budget: searches depth 1, 2, ...
+    // and returns the best move of the deepest completed iteration
     // Returns the column number (0-6) or -1 if no valid move
-    int8_t calculateBestMove(Connect4Board& board, Player player, uint8_t depth) const;
+    int8_t calculateBestMoveTimed(Board& board, Player player, uint32_t maxMillis);
+    int8_t calculateBestMoveTimed(BitBoard& board, Player player, uint32_t maxMillis);
+
+    // Score every column for player in one search to the given depth (at
+    // most MAX_PLY), for hints: scores[col] is the score of playing col
+    // (as getLastScore), NO_SCORE for a full column. Each column gets a
+    // full window, and the columns share the table. Solved instead with
+    // perfect play; the opening book is not used and the search runs on
+    // one thread.
+    // With lines, line col (lines[col * lineLength]) receives col and the
+    // replies expected after it, padded with -1.
+    // Returns the best column (as calculateBestMove, with getLastScore and
+    // getPrincipalVariation), or -1 if the game is over
+    int8_t analyzeMoves(Board& board, Player player, uint8_t depth, int32_t scores[Cols],
+                        int8_t* lines = nullptr, uint8_t lineLength = 0);
+    int8_t analyzeMoves(BitBoard& board, Player player, uint8_t depth, int32_t scores[Cols],
+                        int8_t* lines = nullptr, uint8_t lineLength = 0);
 };
 
+#include "Connect4AIImpl.h"
+
+// The standard board is compiled once, in Connect4AI.cpp
+extern template class BasicConnect4AI<>;
+typedef BasicConnect4AI<> Connect4AI;
+
 #endif // CONNECT4_AI_H
@@ -0,0 +1,1169 @@
+#ifndef CONNECT4_AI_IMPL_H
+#define CONNECT4_AI_IMPL_H
+
+// Member definitions of BasicConnect4AI, included by Connect4AI.h
+
+#if CONNECT4_THREADS
+#include <thread>
+#include <vector>
+#endif
+
+// Millisecond clock for timed searches - Arduino compatibility
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint32_t BasicConnect4AI<Rows, Cols, Win>::nowMillis() {
+#ifdef ARDUINO
+    return millis();
+#else
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4AI<Rows, Cols, Win>::solutionScore(const Connect4Solution& solution) {
+    // Beyond +/-WIN_SCORE when decided, like search scores
+    if (solution.score > 0) return WIN_SCORE + solution.score;
+    if (solution.score < 0) return -WIN_SCORE + solution.score;
+    return 0;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::play(BitBoard& board, uint8_t col, Player player) {
+    uint8_t row = board.getColumnHeight(col);
+    board.makeMove(col, player);
+    evaluator.addStone(row, col, player);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::unplay(BitBoard& board, uint8_t col) {
+    uint8_t row = board.getColumnHeight(col) - 1;
+    evaluator.removeStone(row, col, board.getCell(row, col));
+    board.undoMove(col);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4AI<Rows, Cols, Win>::shouldStop() const {
+    if (hasDeadline && nowMillis() - searchStart >= searchBudget) {
+        return true;
+    }
+#if CONNECT4_THREADS
+    if (stopFlag && stopFlag->load(std::memory_order_relaxed)) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint64_t BasicConnect4AI<Rows, Cols, Win>::tableKey(const BitBoard& board, bool maximizing, Player aiPlayer,
+                                                     uint64_t weightsKey) {
+    // Scores are from aiPlayer's point of view and depend on who is to move,
+    // so both are folded into the key above the position bits
+    uint64_t key = board.getCanonicalKey() ^ weightsKey;
+    if (maximizing) key ^= keyFlag(0);
+    if (aiPlayer == Player::SECOND) key ^= keyFlag(1);
+    return key;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint64_t BasicConnect4AI<Rows, Cols, Win>::keyOfWeights(const Connect4EvalWeights& weights) {
+    const Connect4EvalWeights defaults = Evaluator::defaultWeights();
+    if (weights.three == defaults.three && weights.two == defaults.two &&
+        weights.opponentThree == defaults.opponentThree && weights.opponentTwo == defaults.opponentTwo &&
+        weights.center == defaults.center) {
+        return 0;
+    }
+    
+    // Any bits may differ: like the key flags on wide boards, another
+    // position's key then matches only by an unlikely collision
+    const int32_t values[5] = {weights.three, weights.two, weights.opponentThree, weights.opponentTwo,
+                               weights.center};
+    uint64_t key = 0;
+    for (uint8_t i = 0; i < 5; i++) {
+        key = (key ^ static_cast<uint32_t>(values[i])) * UINT64_C(0x9E3779B97F4A7C15);
+        key ^= key >> 29;
+    }
+    return key ? key : 1;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::probeMove(const BitBoard& board, bool maximizing, Player aiPlayer,
+                                                   bool solver) const {
+    if (!table) return -1;
+    
+    uint64_t key;
+    if (solver) {
+        // Solver entries are keyed by the side to move (see solveNegamax)
+        bool second = (aiPlayer == Player::SECOND) == maximizing;
+        key = board.getCanonicalKey() ^ keyFlag(2);
+        if (second) key ^= keyFlag(3);
+    } else {
+        key = tableKey(board, maximizing, aiPlayer, weightsKey);
+    }
+    
+    Connect4TTEntry entry;
+    if (!table->probe(key, entry)) return -1;
+    int8_t move = tableMove(board, entry.bestMove);
+    return board.isValidMove(move) ? move : -1;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4AI<Rows, Cols, Win>::tableLine(const BitBoard& board, Player player, int8_t move, bool solver,
+                                                    int8_t* line, uint8_t maxLength) const {
+    uint8_t length = 0;
+    if (move < 0 || maxLength == 0) return 0;
+    line[length++] = move;
+    
+    // Follow the table moves from the position after move; the table may
+    // have lost some entries, so the line can stop early
+    BitBoard position(board);
+    Player current = player;
+    bool maximizing = true;
+    while (true) {
+        position.makeMove(static_cast<uint8_t>(line[length - 1]), current);
+        current = (current == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        maximizing = !maximizing;
+        if (position.isGameOver() || length == maxLength) break;
+        
+        int8_t next = probeMove(position, maximizing, player, solver);
+        if (next < 0) break;
+        line[length++] = next;
+    }
+    return length;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4AI<Rows, Cols, Win>::getPrincipalVariation(int8_t* moves, uint8_t maxMoves) const {
+    uint8_t count = pvLength < maxMoves ? pvLength : maxMoves;
+    for (uint8_t i = 0; i < count; i++) {
+        moves[i] = pv[i];
+    }
+    return count;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::orderMoves(int8_t firstMove, uint8_t moveOrder[Cols]) {
+    const uint8_t* centerOrder = Connect4CenterOrder<Cols>::columns;
+    
+    uint8_t count = 0;
+    if (firstMove >= 0 && firstMove < Cols) {
+        moveOrder[count++] = static_cast<uint8_t>(firstMove);
+    }
+    for (uint8_t i = 0; i < Cols; i++) {
+        if (centerOrder[i] != firstMove) {
+            moveOrder[count++] = centerOrder[i];
+        }
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::orderNodeMoves(const BitBoard& board, uint8_t ply, Player player,
+                                int8_t ttMove, uint8_t moveOrder[Cols]) const {
+    const uint8_t* centerOrder = Connect4CenterOrder<Cols>::columns;
+    const uint16_t* playerHistory = history[player == Player::FIRST ? 0 : 1];
+    
+    // Sort key: table move, then killers, then history, center-out on ties
+    uint32_t keys[Cols];
+    for (uint8_t i = 0; i < Cols; i++) {
+        uint8_t col = centerOrder[i];
+        uint32_t key = 0;
+        if (board.isValidMove(col)) {
+            key = playerHistory[col * Rows + board.getColumnHeight(col)] + 1;
+        }
+        if (col == killers[ply][1]) key = UINT32_C(1) << 17;
+        if (col == killers[ply][0]) key = UINT32_C(1) << 18;
+        if (col == ttMove) key = UINT32_C(1) << 19;
+        
+        // Insertion sort, stable so equal keys keep the center-out order
+        uint8_t j = i;
+        while (j > 0 && keys[j - 1] < key) {
+            keys[j] = keys[j - 1];
+            moveOrder[j] = moveOrder[j - 1];
+            j--;
+        }
+        keys[j] = key;
+        moveOrder[j] = col;
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::recordCutoff(const BitBoard& board, uint8_t ply, Player player,
+                              uint8_t col, uint8_t depth) {
+    if (killers[ply][0] != col) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = col;
+    }
+    
+    // Deep cutoffs count more; halve everything before the counters overflow.
+    // The move was undone, so the column height is the cell it was played on
+    uint16_t* playerHistory = history[player == Player::FIRST ? 0 : 1];
+    uint16_t& entry = playerHistory[col * Rows + board.getColumnHeight(col)];
+    uint16_t bonus = static_cast<uint16_t>(depth) * depth;
+    if (entry > UINT16_MAX - bonus) {
+        for (uint8_t p = 0; p < 2; p++) {
+            for (uint8_t i = 0; i < CELLS; i++) {
+                history[p][i] /= 2;
+            }
+        }
+    }
+    entry += bonus;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4AI<Rows, Cols, Win>::minimax(BitBoard& board, uint8_t depth, int32_t alpha, int32_t beta, 
+                            bool maximizing, Player aiPlayer) {
+    // Poll every few nodes; an aborted result is discarded by the caller
+    if ((++nodeCount & 1023) == 0 && shouldStop()) {
+        aborted = true;
+    }
+    if (aborted) return 0;
+    
+    uint8_t ply = board.getMoveCount() - rootMoveCount;
+    CONNECT4_STAT(if (ply > stats.maxDepth) stats.maxDepth = ply);
+    CONNECT4_STAT(noteStack(&ply));
+    
+    // Terminal conditions
+    if (board.hasWinner()) {
+        if (board.getWinner() == aiPlayer) {
+            return WIN_SCORE + depth; // Prefer faster wins
+        } else {
+            return -WIN_SCORE - depth; // Delay losses
+        }
+    }
+    
+    if (board.isDraw() || depth == 0) {
+        CONNECT4_STAT(stats.leafEvaluations++);
+        return evaluator.getScore(aiPlayer);
+    }
+    
+    Player currentPlayer = maximizing ? aiPlayer : 
+                          (aiPlayer == Player::FIRST ? Player::SECOND : Player::FIRST);
+    
+    // The side to move wins with its next stone: no need to search
+    if (board.canWinNext(currentPlayer)) {
+        int32_t score = WIN_SCORE + depth - 1;
+        return maximizing ? score : -score;
+    }
+    
+    // Only search moves that do not give the opponent an immediate win
+    Bits moves = board.getNonLosingCells(currentPlayer);
+    if (moves == 0) {
+        // Every move loses to the opponent's reply
+        int32_t score = WIN_SCORE + (depth >= 2 ? depth - 2 : 0);
+        return maximizing ? -score : score;
+    }
+    
+    // Transposition table lookup
+    uint64_t key = tableKey(board, maximizing, aiPlayer, weightsKey);
+    int32_t alphaOrig = alpha;
+    int32_t betaOrig = beta;
+    int8_t ttMove = -1;
+    Connect4TTEntry entry;
+    CONNECT4_STAT(if (table) stats.tableProbes++);
+    if (table && table->probe(key, entry)) {
+        CONNECT4_STAT(stats.tableHits++);
+        ttMove = tableMove(board, entry.bestMove);
+        if (entry.depth >= depth) {
+            if (entry.bound == TTBound::EXACT) return entry.score;
+            if (entry.bound == TTBound::LOWER && entry.score > alpha) alpha = entry.score;
+            if (entry.bound == TTBound::UPPER && entry.score < beta) beta = entry.score;
+            if (beta <= alpha) return entry.score;
+        }
+    }
+    
+    // Table move, killers, then by history
+    uint8_t moveOrder[Cols];
+    orderNodeMoves(board, ply, currentPlayer, ttMove, moveOrder);
+    
+    int32_t bestEval;
+    int8_t bestMove = -1;
+    uint8_t searched = 0;
+    
+    if (maximizing) {
+        bestEval = INT32_MIN;
+        
+        for (uint8_t i = 0; i < Cols; i++) {
+            uint8_t col = moveOrder[i];
+            
+            if (!(moves & BitBoard::columnMask(col))) continue;
+            
+            searched++;
+            bool reduced = reduces(board, currentPlayer, col, searched, depth);
+            play(board, col, currentPlayer);
+            int32_t eval;
+            if (reduced) {
+                // Prove the late move is no better than alpha a ply shallower
+                CONNECT4_STAT(stats.reducedMoves++);
+                eval = minimax(board, depth - 2, alpha, alpha + 1, false, aiPlayer);
+                if (eval > alpha && !aborted) {
+                    CONNECT4_STAT(stats.reductionResearches++);
+                    eval = minimax(board, depth - 1, alpha, beta, false, aiPlayer);
+                }
+            } else {
+                eval = minimax(board, depth - 1, alpha, beta, false, aiPlayer);
+            }
+            unplay(board, col);
+            
+            if (eval > bestEval || bestMove < 0) {
+                bestEval = eval;
+                bestMove = col;
+            }
+            alpha = (alpha > eval) ? alpha : eval;
+            
+            if (beta <= alpha) { // Alpha-beta pruning
+                recordCutoff(board, ply, currentPlayer, col, depth);
+                CONNECT4_STAT(stats.betaCutoffs++);
+                CONNECT4_STAT(if (searched == 1) stats.firstMoveCutoffs++);
+                break;
+            }
+        }
+    } else {
+        bestEval = INT32_MAX;
+        
+        for (uint8_t i = 0; i < Cols; i++) {
+            uint8_t col = moveOrder[i];
+            
+            if (!(moves & BitBoard::columnMask(col))) continue;
+            
+            searched++;
+            bool reduced = reduces(board, currentPlayer, col, searched, depth);
+            play(board, col, currentPlayer);
+            int32_t eval;
+            if (reduced) {
+                CONNECT4_STAT(stats.reducedMoves++);
+                eval = minimax(board, depth - 2, beta - 1, beta, true, aiPlayer);
+                if (eval < beta && !aborted) {
+                    CONNECT4_STAT(stats.reductionResearches++);
+                    eval = minimax(board, depth - 1, alpha, beta, true, aiPlayer);
+                }
+            } else {
+                eval = minimax(board, depth - 1, alpha, beta, true, aiPlayer);
+            }
+            unplay(board, col);
+            
+            if (eval < bestEval || bestMove < 0) {
+                bestEval = eval;
+                bestMove = col;
+            }
+            beta = (beta < eval) ? beta : eval;
+            
+            if (beta <= alpha) { // Alpha-beta pruning
+                recordCutoff(board, ply, currentPlayer, col, depth);
+                CONNECT4_STAT(stats.betaCutoffs++);
+                CONNECT4_STAT(if (searched == 1) stats.firstMoveCutoffs++);
+                break;
+            }
+        }
+    }
+    
+    if (table && !aborted) {
+        TTBound bound = TTBound::EXACT;
+        if (bestEval <= alphaOrig) bound = TTBound::UPPER;
+        else if (bestEval >= betaOrig) bound = TTBound::LOWER;
+        table->store(key, depth, bound, bestEval, tableMove(board, bestMove));
+    }
+    
+    return bestEval;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4AI<Rows, Cols, Win>::negamax(BitBoard& board, uint8_t depth, int32_t alpha, int32_t beta,
+                            bool maximizing, Player aiPlayer) {
+    if ((++nodeCount & 1023) == 0 && shouldStop()) {
+        aborted = true;
+    }
+    if (aborted) return 0;
+    
+    uint8_t ply = board.getMoveCount() - rootMoveCount;
+    CONNECT4_STAT(if (ply > stats.maxDepth) stats.maxDepth = ply);
+    CONNECT4_STAT(noteStack(&ply));
+    
+    // Converts aiPlayer's scores (evaluator, table) to the side to move's
+    int32_t sign = maximizing ? 1 : -1;
+    
+    // The previous move won: the side to move has lost
+    if (board.hasWinner()) {
+        return -WIN_SCORE - depth;
+    }
+    
+    if (board.isDraw() || depth == 0) {
+        CONNECT4_STAT(stats.leafEvaluations++);
+        return sign * evaluator.getScore(aiPlayer);
+    }
+    
+    Player currentPlayer = maximizing ? aiPlayer : 
+                          (aiPlayer == Player::FIRST ? Player::SECOND : Player::FIRST);
+    
+    if (board.canWinNext(currentPlayer)) {
+        return WIN_SCORE + depth - 1;
+    }
+    
+    Bits moves = board.getNonLosingCells(currentPlayer);
+    if (moves == 0) {
+        return -WIN_SCORE - (depth >= 2 ? depth - 2 : 0);
+    }
+    
+    // Transposition table lookup; a bound for the minimizing side is the
+    // opposite bound once negated
+    uint64_t key = tableKey(board, maximizing, aiPlayer, weightsKey);
+    int32_t alphaOrig = alpha;
+    int32_t betaOrig = beta;
+    int8_t ttMove = -1;
+    Connect4TTEntry entry;
+    CONNECT4_STAT(if (table) stats.tableProbes++);
+    if (table && table->probe(key, entry)) {
+        CONNECT4_STAT(stats.tableHits++);
+        ttMove = tableMove(board, entry.bestMove);
+        if (entry.depth >= depth) {
+            int32_t score = sign * entry.score;
+            TTBound bound = entry.bound;
+            if (!maximizing && bound == TTBound::LOWER) bound = TTBound::UPPER;
+            else if (!maximizing && bound == TTBound::UPPER) bound = TTBound::LOWER;
+            
+            if (bound == TTBound::EXACT) return score;
+            if (bound == TTBound::LOWER && score > alpha) alpha = score;
+            if (bound == TTBound::UPPER && score < beta) beta = score;
+            if (beta <= alpha) return score;
+        }
+    }
+    
+    uint8_t moveOrder[Cols];
+    orderNodeMoves(board, ply, currentPlayer, ttMove, moveOrder);
+    
+    int32_t bestEval = -INT32_MAX;
+    int8_t bestMove = -1;
+    uint8_t searched = 0;
+    
+    for (uint8_t i = 0; i < Cols; i++) {
+        uint8_t col = moveOrder[i];
+        
+        if (!(moves & BitBoard::columnMask(col))) continue;
+        
+        searched++;
+        bool reduced = reduces(board, currentPlayer, col, searched, depth);
+        play(board, col, currentPlayer);
+        int32_t eval;
+        if (searched == 1) {
+            eval = -negamax(board, depth - 1, -beta, -alpha, !maximizing, aiPlayer);
+        } else {
+            // Prove the move is no better than alpha (a ply shallower for a
+            // late move); search again if it is
+            eval = -negamax(board, depth - (reduced ? 2 : 1), -alpha - 1, -alpha, !maximizing, aiPlayer);
+            CONNECT4_STAT(if (reduced) stats.reducedMoves++);
+            if (reduced && eval > alpha) {
+                CONNECT4_STAT(stats.reductionResearches++);
+                eval = -negamax(board, depth - 1, -alpha - 1, -alpha, !maximizing, aiPlayer);
+            }
+            if (eval > alpha && eval < beta) {
+                eval = -negamax(board, depth - 1, -beta, -alpha, !maximizing, aiPlayer);
+            }
+        }
+        unplay(board, col);
+        
+        if (eval > bestEval || bestMove < 0) {
+            bestEval = eval;
+            bestMove = col;
+        }
+        alpha = (alpha > eval) ? alpha : eval;
+        
+        if (beta <= alpha) {
+            recordCutoff(board, ply, currentPlayer, col, depth);
+            CONNECT4_STAT(stats.betaCutoffs++);
+            CONNECT4_STAT(if (searched == 1) stats.firstMoveCutoffs++);
+            break;
+        }
+    }
+    
+    if (table && !aborted) {
+        TTBound bound = TTBound::EXACT;
+        if (bestEval <= alphaOrig) bound = maximizing ? TTBound::UPPER : TTBound::LOWER;
+        else if (bestEval >= betaOrig) bound = maximizing ? TTBound::LOWER : TTBound::UPPER;
+        table->store(key, depth, bound, sign * bestEval, tableMove(board, bestMove));
+    }
+    
+    return bestEval;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::searchMTDF(BitBoard& board, Player player, uint8_t depth,
+                              int32_t guess, int32_t& bestScore) {
+    // Each null-window search moves one bound of the root score towards
+    // the other until they meet
+    int32_t lower = -INT32_MAX;
+    int32_t upper = INT32_MAX;
+    int32_t score = guess;
+    int8_t bestMove = -1;
+    uint64_t key = tableKey(board, true, player, weightsKey);
+    
+    while (lower < upper) {
+        int32_t beta = (score == lower) ? score + 1 : score;
+        score = negamax(board, depth, beta - 1, beta, true, player);
+        if (aborted) return -1;
+        
+        if (score < beta) {
+            upper = score;
+        } else {
+            // Only a fail high proves the root entry's move reaches the score
+            lower = score;
+            Connect4TTEntry entry;
+            bestMove = table->probe(key, entry) ? tableMove(board, entry.bestMove) : -1;
+            if (!board.isValidMove(bestMove)) bestMove = -1;
+        }
+    }
+    
+    if (bestMove >= 0) bestScore = score;
+    return bestMove;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::searchRoot(BitBoard& board, Player player, uint8_t depth,
+                             int8_t firstMove, int32_t& bestScore, int32_t alpha, int32_t beta) {
+    int8_t bestMove = -1;
+    bestScore = INT32_MIN;
+    
+    // Take an immediate win, otherwise skip moves that lose at once
+    // (unless every move does: a move must still be returned)
+    Bits moves = board.getPlayableCells();
+    if (board.canWinNext(player)) {
+        moves &= board.getWinningCells(player);
+    } else if (board.getNonLosingCells(player)) {
+        moves = board.getNonLosingCells(player);
+    }
+    // In a symmetric position a move and its mirror are worth the same
+    if (board.isSymmetric()) {
+        moves &= BitBoard::leftHalfMask();
+    }
+    
+    // MTD(f) starts from the previous iteration's score; without a move
+    // from the table, fall back to a PVS root search
+    if (algorithm == SearchAlgorithm::MTDF && table && !board.canWinNext(player) &&
+        board.getNonLosingCells(player)) {
+        int8_t move = searchMTDF(board, player, depth, lastScore, bestScore);
+        if (move >= 0 || aborted) return move;
+    }
+    
+    // Try firstMove, then columns from center outward
+    uint8_t moveOrder[Cols];
+    orderMoves(firstMove, moveOrder);
+    
+    for (uint8_t i = 0; i < Cols; i++) {
+        uint8_t col = moveOrder[i];
+        
+        if (!(moves & BitBoard::columnMask(col))) continue;
+        
+        play(board, col, player);
+        
+        // Check for immediate win
+        if (board.hasWinner() && board.getWinner() == player) {
+            unplay(board, col);
+            bestScore = WIN_SCORE + depth;
+            return col;
+        }
+        
+        // Moves that cannot beat bestScore only need to be proven worse
+        int32_t low = bestScore > alpha ? bestScore : alpha;
+        int32_t score;
+        if (algorithm == SearchAlgorithm::MINIMAX) {
+            score = minimax(board, depth - 1, low, beta, false, player);
+        } else if (bestMove < 0) {
+            score = -negamax(board, depth - 1, -beta, -low, false, player);
+        } else {
+            score = -negamax(board, depth - 1, -low - 1, -low, false, player);
+            if (score > low && score < beta && !aborted) {
+                score = -negamax(board, depth - 1, -beta, -low, false, player);
+            }
+        }
+        unplay(board, col);
+        
+        if (aborted) return bestMove;
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = col;
+        }
+        if (bestScore >= beta) break;  // Above the window: a lower bound only
+    }
+    
+    return bestMove;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4AI<Rows, Cols, Win>::scoreMove(BitBoard& board, Player player, uint8_t col, uint8_t depth,
+                                                    bool solver) {
+    if (solver) {
+        // Solver scores of the position after col, for the opponent to move
+        Player opponent = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        board.makeMove(col, player);
+        Connect4Solution solution;
+        int8_t reply;
+        solution.score = static_cast<int8_t>(board.hasWinner() ? (CELLS + 2 - board.getMoveCount()) / 2
+                                                               : -solveScore(board, opponent, reply));
+        board.undoMove(col);
+        return solutionScore(solution);
+    }
+    
+    // Same scores as searchRoot, but never cut by the other columns
+    int32_t score;
+    play(board, col, player);
+    if (board.hasWinner()) {
+        score = WIN_SCORE + depth;
+    } else if (algorithm == SearchAlgorithm::MINIMAX) {
+        score = minimax(board, depth - 1, INT32_MIN, INT32_MAX, false, player);
+    } else {
+        score = -negamax(board, depth - 1, -INT32_MAX, INT32_MAX, false, player);
+    }
+    unplay(board, col);
+    return score;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4AI<Rows, Cols, Win>::orderSolverMoves(const BitBoard& board, Player player, Bits mask,
+                                     uint8_t order[Cols]) {
+    // Moves creating the most winning cells first, center first on ties
+    const uint8_t* centerOrder = Connect4CenterOrder<Cols>::columns;
+    uint8_t threats[Cols];
+    uint8_t count = 0;
+    
+    for (uint8_t i = 0; i < Cols; i++) {
+        uint8_t col = centerOrder[i];
+        if (!(mask & BitBoard::columnMask(col))) continue;
+        
+        uint8_t value = BitBoard::popCount(board.getWinningCellsAfter(player, col));
+        
+        uint8_t j = count++;
+        for (; j > 0 && threats[j - 1] < value; j--) {
+            threats[j] = threats[j - 1];
+            order[j] = order[j - 1];
+        }
+        threats[j] = value;
+        order[j] = col;
+    }
+    return count;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4AI<Rows, Cols, Win>::solveNegamax(BitBoard& board, Player player, int32_t alpha, int32_t beta) {
+    if ((++nodeCount & 1023) == 0 && shouldStop()) {
+        aborted = true;
+    }
+    if (aborted) return 0;
+    
+    CONNECT4_STAT(uint8_t ply = board.getMoveCount() - rootMoveCount);
+    CONNECT4_STAT(if (ply > stats.maxDepth) stats.maxDepth = ply);
+    CONNECT4_STAT(noteStack(&ply));
+    
+    int32_t stones = board.getMoveCount();
+    Bits moves = board.getNonLosingCells(player);
+    if (moves == 0) {
+        return -(CELLS - stones) / 2;  // The opponent wins with the next stone
+    }
+    if (stones >= CELLS - 2) {
+        return 0;  // Neither side can win with the last two stones
+    }
+    
+    // Best and worst outcomes still possible
+    int32_t lowest = -(CELLS - 2 - stones) / 2;
+    if (alpha < lowest) {
+        alpha = lowest;
+        if (alpha >= beta) return alpha;
+    }
+    int32_t highest = (CELLS - 1 - stones) / 2;
+    if (beta > highest) {
+        beta = highest;
+        if (alpha >= beta) return beta;
+    }
+    
+    // Positions of a solved book need no search
+    int32_t known;
+    if (bookScore(board, player, known)) return known;
+    
+    // Solver entries live beside search entries under their own key bits
+    uint64_t key = board.getCanonicalKey() ^ keyFlag(2);
+    if (player == Player::SECOND) key ^= keyFlag(3);
+    Connect4TTEntry entry;
+    CONNECT4_STAT(if (table) stats.tableProbes++);
+    if (table && table->probe(key, entry)) {
+        CONNECT4_STAT(stats.tableHits++);
+        if (entry.bound == TTBound::UPPER && entry.score < beta) {
+            beta = entry.score;
+            if (alpha >= beta) return beta;
+        } else if (entry.bound == TTBound::LOWER && entry.score > alpha) {
+            alpha = entry.score;
+            if (alpha >= beta) return alpha;
+        }
+    }
+    
+    Player opponent = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    uint8_t order[Cols];
+    uint8_t count = orderSolverMoves(board, player, moves, order);
+    
+    for (uint8_t i = 0; i < count; i++) {
+        board.makeMove(order[i], player);
+        int32_t score = -solveNegamax(board, opponent, -beta, -alpha);
+        board.undoMove(order[i]);
+        if (aborted) return 0;
+        
+        if (score >= beta) {
+            CONNECT4_STAT(stats.betaCutoffs++);
+            CONNECT4_STAT(if (i == 0) stats.firstMoveCutoffs++);
+            if (table) table->store(key, SOLVER_DEPTH, TTBound::LOWER, score, tableMove(board, order[i]));
+            return score;
+        }
+        if (score > alpha) alpha = score;
+    }
+    
+    if (table) table->store(key, SOLVER_DEPTH, TTBound::UPPER, alpha, -1);
+    return alpha;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4AI<Rows, Cols, Win>::solveScore(BitBoard& board, Player player, int8_t& bestMove) {
+    bestMove = -1;
+    int32_t stones = board.getMoveCount();
+    if (board.canWinNext(player)) {
+        return (CELLS + 1 - stones) / 2;
+    }
+    int32_t known;
+    if (bookScore(board, player, known)) {
+        bestMove = book->lookup(board);
+        return known;
+    }
+    
+    // Null-window probes, biased towards 0 and the extremes: positions are
+    // mostly decided early, and small windows prune the most
+    int32_t lowest = -(CELLS - stones) / 2;
+    int32_t highest = (CELLS + 1 - stones) / 2;
+    while (lowest < highest) {
+        int32_t middle = lowest + (highest - lowest) / 2;
+        if (middle <= 0 && lowest / 2 < middle) middle = lowest / 2;
+        else if (middle >= 0 && highest / 2 > middle) middle = highest / 2;
+        
+        int32_t score = solveNegamax(board, player, middle, middle + 1);
+        if (aborted) return 0;
+        
+        if (score <= middle) {
+            highest = score;
+        } else {
+            // The root entry, just stored, holds the move failing high: it
+            // reaches lowest (later probes may replace the entry)
+            lowest = score;
+            bestMove = probeMove(board, true, player, true);
+        }
+    }
+    return lowest;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::solveRoot(BitBoard& board, Player player, Connect4Solution& solution) {
+    solution.score = 0;
+    solution.distance = 0;
+    solution.bestMove = -1;
+    if (board.isGameOver() || !canSolve(board)) return;
+    
+    int8_t proved;
+    int32_t score = solveScore(board, player, proved);
+    if (aborted) return;
+    
+    // A move reaches score if the opponent cannot do better than -score
+    // after it; when every move loses, any of them does
+    Player opponent = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    Bits moves = board.getPlayableCells();
+    if (board.canWinNext(player)) {
+        moves &= board.getWinningCells(player);
+    } else if (board.getNonLosingCells(player)) {
+        moves = board.getNonLosingCells(player);
+        if (proved >= 0 && (moves & BitBoard::columnMask(proved))) solution.bestMove = proved;
+        
+        // Otherwise search the moves for one reaching the score
+        if (board.isSymmetric()) {
+            moves &= BitBoard::leftHalfMask();
+        }
+        uint8_t order[Cols];
+        uint8_t count = solution.bestMove < 0 ? orderSolverMoves(board, player, moves, order) : 0;
+        for (uint8_t i = 0; i < count && solution.bestMove < 0; i++) {
+            board.makeMove(order[i], player);
+            int32_t reply = solveNegamax(board, opponent, -score, -score + 1);
+            board.undoMove(order[i]);
+            if (aborted) return;
+            if (reply <= -score) solution.bestMove = order[i];
+        }
+    }
+    if (solution.bestMove < 0) {
+        uint8_t order[Cols];
+        orderMoves(-1, order);
+        for (uint8_t i = 0; i < Cols && solution.bestMove < 0; i++) {
+            if (moves & BitBoard::columnMask(order[i])) solution.bestMove = order[i];
+        }
+    }
+    
+    // The game ends with stone number end, played by the winner
+    // (an odd distance when player wins, even when it loses)
+    int32_t magnitude = score < 0 ? -score : score;
+    int32_t end = CELLS + 1 - 2 * magnitude;
+    if (score != 0 && ((end - board.getMoveCount()) & 1) != (score > 0 ? 1 : 0)) end++;
+    solution.score = static_cast<int8_t>(score);
+    solution.distance = static_cast<uint8_t>(score == 0 ? CELLS - board.getMoveCount()
+                                                        : end - board.getMoveCount());
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+Connect4Solution BasicConnect4AI<Rows, Cols, Win>::solve(Board& board, Player player) {
+    BitBoard bitBoard(board);
+    return solve(bitBoard, player);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+Connect4Solution BasicConnect4AI<Rows, Cols, Win>::solve(BitBoard& board, Player player) {
+    beginSearch(board);
+    if (table) table->newSearch();
+    
+    Connect4Solution solution;
+    solveRoot(board, player, solution);
+    lastScore = solutionScore(solution);
+    recordPV(board, player, solution.bestMove, true);
+    
+    CONNECT4_STAT(stats.nodes = nodeCount);
+    return solution;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::calculateBestMove(Board& board, Player player, uint8_t depth) {
+    // Search on a bitboard copy: much cheaper make/undo and win detection
+    BitBoard bitBoard(board);
+    return calculateBestMove(bitBoard, player, depth);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::searchAspiration(BitBoard& board, Player player, uint8_t depth,
+                                   int8_t firstMove, int32_t& score) {
+    int32_t window = aspirationWindow;
+    if (window == 0 || window >= WIN_SCORE || depth == 1 || algorithm == SearchAlgorithm::MTDF ||
+        lastScore >= WIN_SCORE || lastScore <= -WIN_SCORE) {
+        return searchRoot(board, player, depth, firstMove, score);
+    }
+    
+    // Around the previous iteration's score; a score outside the window
+    // is only a bound, so widen that side and search again
+    int32_t alpha = lastScore - window;
+    int32_t beta = lastScore + window;
+    for (;;) {
+        int8_t move = searchRoot(board, player, depth, firstMove, score, alpha, beta);
+        if (aborted) return move;
+        
+        if (score <= alpha) {
+            window *= 4;
+            alpha = (window >= WIN_SCORE || score <= -WIN_SCORE) ? -INT32_MAX : score - window;
+        } else if (score >= beta) {
+            window *= 4;
+            beta = (window >= WIN_SCORE || score >= WIN_SCORE) ? INT32_MAX : score + window;
+            firstMove = move;  // The move that failed high is searched first
+        } else {
+            return move;
+        }
+        CONNECT4_STAT(stats.aspirationResearches++);
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::deepen(BitBoard& board, Player player, uint8_t maxDepth, bool timed) {
+    // Depth 1 starts from the table move left by earlier searches
+    int8_t bestMove = probeMove(board, true, player, false);
+    
+    for (uint8_t depth = 1; depth <= maxDepth; depth++) {
+        // Depth 1 always completes so a move is returned even on a tiny budget
+        hasDeadline = timed && depth > 1;
+        
+        CONNECT4_STAT(uint32_t iterationStart = nowMillis());
+        int32_t score;
+        int8_t move = searchAspiration(board, player, depth, bestMove, score);
+        
+        if (aborted) break;  // Keep the last completed iteration
+        
+        bestMove = move;
+        lastScore = score;
+        CONNECT4_STAT(
+            if (stats.iterations < SearchStats::MAX_ITERATIONS) {
+                stats.iterationMillis[stats.iterations++] = nowMillis() - iterationStart;
+            }
+        )
+        
+        // A forced result will not change with more depth
+        if (score >= WIN_SCORE || score <= -WIN_SCORE) break;
+        if (timed && nowMillis() - searchStart >= searchBudget) break;
+    }
+    
+    hasDeadline = false;
+    return bestMove;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::helperSearch(BitBoard& board, Player player, uint8_t maxDepth, uint8_t helperIndex) {
+    // Lazy SMP helper: its results only matter through the shared table.
+    // Odd helpers run one ply ahead and each starts from a different root
+    // column so the threads spread over the tree instead of duplicating work
+    const uint8_t* centerOrder = Connect4CenterOrder<Cols>::columns;
+    int8_t firstMove = centerOrder[helperIndex % Cols];
+#if CONNECT4_SEARCH_STATS
+    uint8_t marker = 0;
+    stackBase = reinterpret_cast<uintptr_t>(&marker);
+#endif
+    
+    for (uint8_t depth = 1 + (helperIndex & 1); depth <= maxDepth; depth++) {
+        int32_t score;
+        int8_t move = searchRoot(board, player, depth, firstMove, score);
+        if (aborted) break;
+        if (move >= 0) firstMove = move;
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::searchThreads(BitBoard& board, Player player, uint8_t maxDepth, bool timed) {
+#if CONNECT4_THREADS
+    if (threadCount > 1) {
+        std::atomic<bool> stop(false);
+        
+        // Helpers get their own copies of the position and search state;
+        // only the transposition table is shared
+        std::vector<BasicConnect4AI> helpers(threadCount - 1, *this);
+        std::vector<BitBoard> boards(threadCount - 1, board);
+        std::vector<std::thread> threads;
+        
+        for (uint8_t i = 0; i + 1 < threadCount; i++) {
+            helpers[i].hasDeadline = false;
+            helpers[i].aborted = false;
+            helpers[i].nodeCount = 0;
+            CONNECT4_STAT(helpers[i].stats.reset());
+            helpers[i].stopFlag = &stop;
+            threads.push_back(std::thread(&BasicConnect4AI::helperSearch, &helpers[i],
+                                          std::ref(boards[i]), player, maxDepth, static_cast<uint8_t>(i + 1)));
+        }
+        
+        int8_t bestMove = deepen(board, player, maxDepth, timed);
+        
+        stop.store(true, std::memory_order_relaxed);
+        for (size_t i = 0; i < threads.size(); i++) {
+            threads[i].join();
+            nodeCount += helpers[i].nodeCount;
+            CONNECT4_STAT(stats.merge(helpers[i].stats));
+        }
+        return bestMove;
+    }
+#endif
+    return deepen(board, player, maxDepth, timed);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::bookMove(const BitBoard& board, Player player) const {
+    if (!book) return -1;
+    
+    // Book positions come from alternating play: FIRST moves on even plies
+    Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+    if (player != toMove) return -1;
+    
+    int8_t move = book->lookup(board);
+    return (move >= 0 && board.isValidMove(move)) ? move : -1;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4AI<Rows, Cols, Win>::bookScore(const BitBoard& board, Player player, int32_t& score) const {
+    if (!book || !book->isSolved()) return false;
+    
+    // Scores are for the side to move of alternating play, like book moves
+    Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+    int8_t known;
+    if (player != toMove || !book->lookupScore(board, known)) return false;
+    score = known;
+    return true;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4AI<Rows, Cols, Win>::beginSearch(const BitBoard& board) {
+    nodeCount = 0;
+    lastScore = 0;
+    pvLength = 0;
+    CONNECT4_STAT(stats.reset());
+    for (uint8_t i = 0; i < MAX_PLY; i++) {
+        killers[i][0] = NO_MOVE;
+        killers[i][1] = NO_MOVE;
+    }
+    for (uint8_t p = 0; p < 2; p++) {
+        for (uint8_t i = 0; i < CELLS; i++) {
+            history[p][i] = 0;
+        }
+    }
+    rootMoveCount = board.getMoveCount();
+    hasDeadline = false;
+    aborted = false;
+#if CONNECT4_SEARCH_STATS
+    uint8_t marker = 0;
+    stackBase = reinterpret_cast<uintptr_t>(&marker);
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::calculateBestMove(BitBoard& board, Player player, uint8_t depth) {
+    if (depth == 0) depth = 1; // Minimum depth
+    if (depth > MAX_PLY) depth = MAX_PLY;
+    
+    beginSearch(board);
+    int8_t move = bookMove(board, player);
+    if (move >= 0) {
+        recordPV(board, player, move, false);
+        return move;
+    }
+    
+    if (table) table->newSearch();
+    
+    if (perfectPlay && canSolve(board)) {
+        Connect4Solution solution;
+        solveRoot(board, player, solution);
+        lastScore = solutionScore(solution);
+        recordPV(board, player, solution.bestMove, true);
+        CONNECT4_STAT(stats.nodes = nodeCount);
+        return solution.bestMove;
+    }
+    
+    evaluator.load(board);
+    
+    if (threadCount > 1) {
+        move = searchThreads(board, player, depth, false);
+    } else if (aspirationWindow > 0 && algorithm != SearchAlgorithm::MTDF) {
+        // Aspiration windows are centered on the score of the depth before
+        move = deepen(board, player, depth, false);
+    } else {
+        // The previous search of this game usually went through this
+        // position: its table move is the best first guess
+        CONNECT4_STAT(uint32_t searchBegin = nowMillis());
+        int32_t score;
+        move = searchRoot(board, player, depth, probeMove(board, true, player, false), score);
+        lastScore = score;
+        CONNECT4_STAT(stats.iterationMillis[stats.iterations++] = nowMillis() - searchBegin);
+    }
+    
+    recordPV(board, player, move, false);
+    CONNECT4_STAT(stats.nodes = nodeCount);
+    return move;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::calculateBestMoveTimed(Board& board, Player player, uint32_t maxMillis) {
+    BitBoard bitBoard(board);
+    return calculateBestMoveTimed(bitBoard, player, maxMillis);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::calculateBestMoveTimed(BitBoard& board, Player player, uint32_t maxMillis) {
+    beginSearch(board);
+    int8_t move = bookMove(board, player);
+    if (move >= 0) {
+        recordPV(board, player, move, false);
+        return move;
+    }
+    
+    if (table) table->newSearch();
+    evaluator.load(board);
+    searchStart = nowMillis();
+    searchBudget = maxMillis;
+    
+    if (perfectPlay && canSolve(board)) {
+        // Solve within half the budget, otherwise search with what is left
+        Connect4Solution solution;
+        searchBudget = maxMillis / 2;
+        hasDeadline = true;
+        solveRoot(board, player, solution);
+        hasDeadline = false;
+        if (!aborted && solution.bestMove >= 0) {
+            lastScore = solutionScore(solution);
+            recordPV(board, player, solution.bestMove, true);
+            CONNECT4_STAT(stats.nodes = nodeCount);
+            return solution.bestMove;
+        }
+        aborted = false;
+        searchBudget = maxMillis;
+    }
+    
+    uint8_t maxDepth = CELLS - board.getMoveCount();
+    if (maxDepth > MAX_PLY) maxDepth = MAX_PLY;
+    move = searchThreads(board, player, maxDepth, true);
+    
+    recordPV(board, player, move, false);
+    CONNECT4_STAT(stats.nodes = nodeCount);
+    return move;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::analyzeMoves(Board& board, Player player, uint8_t depth, int32_t scores[Cols],
+                                                      int8_t* lines, uint8_t lineLength) {
+    BitBoard bitBoard(board);
+    return analyzeMoves(bitBoard, player, depth, scores, lines, lineLength);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4AI<Rows, Cols, Win>::analyzeMoves(BitBoard& board, Player player, uint8_t depth, int32_t scores[Cols],
+                                                      int8_t* lines, uint8_t lineLength) {
+    if (depth == 0) depth = 1; // Minimum depth
+    if (depth > MAX_PLY) depth = MAX_PLY;
+    
+    beginSearch(board);
+    for (uint8_t col = 0; col < Cols; col++) {
+        scores[col] = NO_SCORE;
+    }
+    if (lines) {
+        for (uint16_t i = 0; i < static_cast<uint16_t>(Cols) * lineLength; i++) {
+            lines[i] = -1;
+        }
+    }
+    if (board.isGameOver() || player == Player::NONE) return -1;
+    
+    if (table) table->newSearch();
+    evaluator.load(board);
+    bool solver = perfectPlay && canSolve(board);
+    
+    // Center-out, so that the columns searched first fill the table for the
+    // others; in a symmetric position the right half mirrors the left
+    const uint8_t* centerOrder = Connect4CenterOrder<Cols>::columns;
+    Bits moves = board.getPlayableCells();
+    bool symmetric = board.isSymmetric();
+    if (symmetric) moves &= BitBoard::leftHalfMask();
+    
+    for (uint8_t i = 0; i < Cols; i++) {
+        uint8_t col = centerOrder[i];
+        if (!(moves & BitBoard::columnMask(col))) continue;
+        
+        scores[col] = scoreMove(board, player, col, depth, solver);
+        if (aborted) break;
+        if (lines) tableLine(board, player, col, solver, lines + col * lineLength, lineLength);
+    }
+    
+    if (symmetric) {
+        for (uint8_t col = 0; col < Cols / 2; col++) {
+            uint8_t mirror = BitBoard::mirrorColumn(col);
+            scores[mirror] = scores[col];
+            if (lines && scores[col] != NO_SCORE) {
+                tableLine(board, player, mirror, solver, lines + mirror * lineLength, lineLength);
+            }
+        }
+    }
+    
+    // Best score, the most central column on ties
+    int8_t bestMove = -1;
+    for (uint8_t i = 0; i < Cols; i++) {
+        uint8_t col = centerOrder[i];
+        if (scores[col] != NO_SCORE && (bestMove < 0 || scores[col] > scores[bestMove])) {
+            bestMove = static_cast<int8_t>(col);
+        }
+    }
+    
+    lastScore = bestMove >= 0 ? scores[bestMove] : 0;
+    recordPV(board, player, bestMove, solver);
+    CONNECT4_STAT(stats.nodes = nodeCount);
+    return bestMove;
+}
+
+#endif // CONNECT4_AI_IMPL_H
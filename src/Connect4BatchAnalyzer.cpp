@@ -0,0 +1,137 @@
+#include "Connect4BatchAnalyzer.h"
+
+#if CONNECT4_THREADS
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Chunks of positions (start indices) waiting for one worker
+struct WorkQueue {
+    std::mutex lock;
+    std::deque<size_t> chunks;
+
+    // Owner takes from the front...
+    bool pop(size_t& chunk) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (chunks.empty()) return false;
+        chunk = chunks.front();
+        chunks.pop_front();
+        return true;
+    }
+
+    // ...thieves from the back, away from the owner's current area
+    bool steal(size_t& chunk) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (chunks.empty()) return false;
+        chunk = chunks.back();
+        chunks.pop_back();
+        return true;
+    }
+};
+
+} // namespace
+
+Connect4BatchAnalyzer::Connect4BatchAnalyzer(uint8_t threads, uint8_t depth, uint8_t tableSizeBits)
+    : threadCount(threads), depth(depth > 0 ? depth : 1), tableSizeBits(tableSizeBits),
+      weights(Connect4Evaluator::defaultWeights()), perfectPlay(false) {
+    if (threadCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        threadCount = static_cast<uint8_t>(hardware == 0 ? 1 : (hardware > 255 ? 255 : hardware));
+    }
+}
+
+bool Connect4BatchAnalyzer::replay(const char* moves, Connect4BitBoard& board) {
+    board.reset();
+    Player player = Player::FIRST;
+    for (const char* m = moves; *m; m++) {
+        if (*m < '1' || *m > '7' || !board.makeMove(static_cast<uint8_t>(*m - '1'), player)) {
+            return false;
+        }
+        player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    }
+    return true;
+}
+
+template <typename Job>
+void Connect4BatchAnalyzer::run(size_t count, Job job) {
+    if (count == 0) return;
+
+    // Contiguous runs of chunks per worker: neighbouring positions (e.g. the
+    // moves of one game) share table entries
+    size_t chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<WorkQueue> queues(threadCount);
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        queues[chunk * threadCount / chunkCount].chunks.push_back(chunk * CHUNK_SIZE);
+    }
+
+    auto worker = [&](uint8_t self) {
+        std::vector<Connect4TTSlot> storage(static_cast<size_t>(1) << tableSizeBits);
+        Connect4TranspositionTable table(&storage[0], tableSizeBits);
+        Connect4AI ai;
+        ai.setTranspositionTable(&table);
+        ai.setEvalWeights(weights);
+        ai.setPerfectPlay(perfectPlay);
+
+        size_t start;
+        for (;;) {
+            bool found = queues[self].pop(start);
+            for (uint8_t i = 1; !found && i < threadCount; i++) {
+                found = queues[(self + i) % threadCount].steal(start);
+            }
+            if (!found) break;  // No work is added once started: all done
+
+            size_t end = (start + CHUNK_SIZE < count) ? start + CHUNK_SIZE : count;
+            for (size_t index = start; index < end; index++) {
+                job(index, ai);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint8_t i = 1; i < threadCount; i++) {
+        threads.push_back(std::thread(worker, i));
+    }
+    worker(0);
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+void Connect4BatchAnalyzer::analyzeBoard(Connect4AI& ai, Connect4BitBoard& board,
+                                         Connect4AnalysisResult& result) const {
+    result.valid = false;
+    result.bestMove = -1;
+    result.score = 0;
+    if (board.isGameOver()) return;
+
+    Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+    result.bestMove = ai.calculateBestMove(board, toMove, depth);
+    result.score = ai.getLastScore();
+    result.valid = result.bestMove >= 0;
+}
+
+void Connect4BatchAnalyzer::analyze(const char* const* moves, size_t count, Connect4AnalysisResult* results) {
+    run(count, [&](size_t index, Connect4AI& ai) {
+        Connect4BitBoard board;
+        if (!replay(moves[index], board)) {
+            results[index].valid = false;
+            results[index].bestMove = -1;
+            results[index].score = 0;
+            return;
+        }
+        analyzeBoard(ai, board, results[index]);
+    });
+}
+
+void Connect4BatchAnalyzer::analyze(const Connect4BitBoard* boards, size_t count, Connect4AnalysisResult* results) {
+    run(count, [&](size_t index, Connect4AI& ai) {
+        Connect4BitBoard board = boards[index];
+        analyzeBoard(ai, board, results[index]);
+    });
+}
+
+#endif // CONNECT4_THREADS
@@ -0,0 +1,72 @@
+#ifndef CONNECT4_BATCH_ANALYZER_H
+#define CONNECT4_BATCH_ANALYZER_H
+
+#include "Connect4AI.h"
+#include <stdint.h>
+
+// Batch analysis is for servers: it needs threads and heap-allocated tables
+#if CONNECT4_THREADS
+
+#include <stddef.h>
+
+struct Connect4AnalysisResult {
+    bool valid;        // False if the position could not be replayed or is over
+    int8_t bestMove;   // Column 0-6, or -1
+    int32_t score;     // Score for the side to move (see Connect4AI::getLastScore)
+};
+
+// Analyzes many independent positions on a pool of worker threads.
+//
+// Each worker owns a Connect4AI and a private transposition table, kept
+// across positions. Positions are split into chunks queued on the workers;
+// a worker that runs out of chunks steals from the back of another worker's
+// queue, so uneven positions (openings vs endgames) still keep every core
+// busy. The side to move follows from alternating play.
+class Connect4BatchAnalyzer {
+public:
+    // threads = 0 uses every hardware thread
+    Connect4BatchAnalyzer(uint8_t threads, uint8_t depth, uint8_t tableSizeBits = 18);
+
+    // Positions as move strings (columns '1'-'7', starting with Player::FIRST)
+    void analyze(const char* const* moves, size_t count, Connect4AnalysisResult* results);
+
+    // Positions as boards
+    void analyze(const Connect4BitBoard* boards, size_t count, Connect4AnalysisResult* results);
+
+    uint8_t getThreads() const {
+        return threadCount;
+    }
+
+    // Settings of the workers' AIs for the next analyze() calls (see
+    // Connect4AI). Tables are cleared between calls, so changing the
+    // weights needs nothing else.
+    void setEvalWeights(const Connect4EvalWeights& newWeights) {
+        weights = newWeights;
+    }
+
+    void setPerfectPlay(bool enabled) {
+        perfectPlay = enabled;
+    }
+
+    // Replay a move string; returns false on an invalid or illegal move
+    static bool replay(const char* moves, Connect4BitBoard& board);
+
+private:
+    static constexpr size_t CHUNK_SIZE = 16;
+
+    uint8_t threadCount;
+    uint8_t depth;
+    uint8_t tableSizeBits;
+    Connect4EvalWeights weights;
+    bool perfectPlay;
+
+    // Runs job(index, ai) for every index in [0, count) on the pool
+    template <typename Job>
+    void run(size_t count, Job job);
+
+    void analyzeBoard(Connect4AI& ai, Connect4BitBoard& board, Connect4AnalysisResult& result) const;
+};
+
+#endif // CONNECT4_THREADS
+
+#endif // CONNECT4_BATCH_ANALYZER_H
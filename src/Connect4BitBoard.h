@@ -0,0 +1,371 @@
+#ifndef CONNECT4_BITBOARD_H
+#define CONNECT4_BITBOARD_H
+
+#include "Connect4Board.h"
+#include "Connect4Geometry.h"
+#include <stdint.h>
+
+// Bitboard representation of the board, used by the AI search.
+//
+// Each column is stored as BOARD_ROWS + 1 consecutive bits (the extra bit is a
+// sentinel that keeps alignments from wrapping into the next column):
+//
+//   .  .  .  .  .  .  .     <- sentinel row
+//   5 12 19 26 33 40 47
+//   4 11 18 25 32 39 46
+//   3 10 17 24 31 38 45
+//   2  9 16 23 30 37 44
+//   1  8 15 22 29 36 43
+//   0  7 14 21 28 35 42
+//
+// Exposes the same makeMove/undoMove/getCell/isValidMove interface as
+// Connect4Board so the two can be used interchangeably. Other geometries
+// work the same way: masks are uint64_t while every column and its sentinel
+// fit in 64 bits, 128-bit integers beyond (9x7, 8x8...; see Connect4Bits).
+//
+// The left-right mirror image of the position is kept alongside it, so the
+// canonical key (the smaller of the two keys) costs no more than the key:
+// mirrored positions have the same value and share table and book entries.
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+class BasicConnect4BitBoard {
+    static_assert((Rows + 1) * Cols <= MAX_BITBOARD_BITS, "Board does not fit a bitboard");
+    static_assert(Win >= 2 && Win <= (Rows > Cols ? Rows : Cols), "Alignment longer than the board");
+
+public:
+    // Cell masks: one bit per cell, Rows + 1 bits per column
+    typedef Connect4Bits<Rows, Cols> Bits;
+
+private:
+    static constexpr uint8_t COLUMN_BITS = Rows + 1;
+    static constexpr Bits BOTTOM_ROW = connect4BottomRow<Rows, Cols>();
+    static constexpr Bits BOARD_MASK = BOTTOM_ROW * ((Bits(1) << Rows) - 1);
+
+    Bits firstStones;   // Stones of Player::FIRST
+    Bits occupied;      // Stones of both players
+    Bits mirrorFirst;   // Same two masks with the columns reversed
+    Bits mirrorOccupied;
+    uint8_t columnHeights[Cols];
+    uint8_t moveCount;
+    GameState state;
+    Player winner;
+
+    static uint64_t hashKey(uint64_t key) {
+        return key;
+    }
+
+#ifdef __SIZEOF_INT128__
+    // Both halves mixed so that keys differing only in the high bits differ
+    static uint64_t hashKey(unsigned __int128 key) {
+        return static_cast<uint64_t>(key) ^
+               static_cast<uint64_t>(key >> 64) * UINT64_C(0x9E3779B97F4A7C15);
+    }
+#endif
+
+    static Bits bottomMask(uint8_t col) {
+        return Bits(1) << (col * COLUMN_BITS);
+    }
+
+    // True if the stones contain Win aligned in any direction
+    static bool hasAlignment(Bits stones) {
+        const uint8_t directions[4] = {
+            1,                  // Vertical
+            COLUMN_BITS,        // Horizontal
+            COLUMN_BITS - 1,    // Diagonal (\)
+            COLUMN_BITS + 1     // Diagonal (/)
+        };
+        for (uint8_t i = 0; i < 4; i++) {
+            uint8_t shift = directions[i];
+            Bits m = stones;
+            for (uint8_t n = 1; n < Win; n++) {
+                m &= stones >> (shift * n);
+            }
+            if (m) return true;
+        }
+        return false;
+    }
+
+    // Cells completing Win stones in a row along one direction:
+    // before[n] / after[n] are the cells with n stones in a row just before /
+    // after them, and a winning cell has j before and Win - 1 - j after
+    static Bits winningCellsAlong(Bits stones, uint8_t shift) {
+        Bits before[Win];
+        Bits after[Win];
+        before[0] = after[0] = ~Bits(0);
+        for (uint8_t n = 1; n < Win; n++) {
+            before[n] = before[n - 1] & (stones << (shift * n));
+            after[n] = after[n - 1] & (stones >> (shift * n));
+        }
+        Bits cells = 0;
+        for (uint8_t j = 0; j < Win; j++) {
+            cells |= before[j] & after[Win - 1 - j];
+        }
+        return cells;
+    }
+
+    // Empty cells that would complete Win stones in a row
+    static Bits winningCells(Bits stones, Bits emptyCells) {
+        // Directions spelled out so each call is unrolled with a constant shift
+        return (winningCellsAlong(stones, 1) |                   // Vertical
+                winningCellsAlong(stones, COLUMN_BITS) |         // Horizontal
+                winningCellsAlong(stones, COLUMN_BITS - 1) |     // Diagonal (\)
+                winningCellsAlong(stones, COLUMN_BITS + 1))      // Diagonal (/)
+               & emptyCells;
+    }
+
+public:
+    // Bits of the position key (keys of more than 64 bits are hashed down to
+    // 64 by getKey())
+    static constexpr uint8_t KEY_BITS = COLUMN_BITS * Cols;
+
+    BasicConnect4BitBoard() {
+        reset();
+    }
+
+    explicit BasicConnect4BitBoard(const BasicConnect4Board<Rows, Cols, Win>& board) {
+        loadFrom(board);
+    }
+
+    void reset() {
+        firstStones = 0;
+        occupied = 0;
+        mirrorFirst = 0;
+        mirrorOccupied = 0;
+        for (uint8_t c = 0; c < Cols; c++) {
+            columnHeights[c] = 0;
+        }
+        moveCount = 0;
+        state = GameState::IN_PROGRESS;
+        winner = Player::NONE;
+    }
+
+    // Copy the position of an array-backed board
+    void loadFrom(const BasicConnect4Board<Rows, Cols, Win>& board) {
+        reset();
+        for (uint8_t c = 0; c < Cols; c++) {
+            uint8_t height = board.getColumnHeight(c);
+            for (uint8_t r = 0; r < height; r++) {
+                Bits bit = bottomMask(c) << r;
+                Bits mirrorBit = bottomMask(mirrorColumn(c)) << r;
+                occupied |= bit;
+                mirrorOccupied |= mirrorBit;
+                if (board.getCell(r, c) == Player::FIRST) {
+                    firstStones |= bit;
+                    mirrorFirst |= mirrorBit;
+                }
+            }
+            columnHeights[c] = height;
+        }
+        moveCount = board.getMoveCount();
+        state = board.getState();
+        winner = board.getWinner();
+    }
+
+    bool isValidMove(uint8_t col) const {
+        return col < Cols && columnHeights[col] < Rows;
+    }
+
+    bool makeMove(uint8_t col, Player player) {
+        if (!isValidMove(col) || state != GameState::IN_PROGRESS) {
+            return false;
+        }
+
+        Bits bit = bottomMask(col) << columnHeights[col];
+        Bits mirrorBit = bottomMask(mirrorColumn(col)) << columnHeights[col];
+        occupied |= bit;
+        mirrorOccupied |= mirrorBit;
+        if (player == Player::FIRST) {
+            firstStones |= bit;
+            mirrorFirst |= mirrorBit;
+        }
+        columnHeights[col]++;
+        moveCount++;
+
+        // Check for win
+        if (hasAlignment(getStones(player))) {
+            state = (player == Player::FIRST) ? GameState::FIRST_WINS : GameState::SECOND_WINS;
+            winner = player;
+        }
+        // Check for draw
+        else if (moveCount >= Rows * Cols) {
+            state = GameState::DRAW;
+        }
+
+        return true;
+    }
+
+    void undoMove(uint8_t col) {
+        if (col >= Cols || columnHeights[col] == 0) {
+            return;
+        }
+
+        columnHeights[col]--;
+        Bits bit = bottomMask(col) << columnHeights[col];
+        Bits mirrorBit = bottomMask(mirrorColumn(col)) << columnHeights[col];
+        occupied &= ~bit;
+        firstStones &= ~bit;
+        mirrorOccupied &= ~mirrorBit;
+        mirrorFirst &= ~mirrorBit;
+        moveCount--;
+        state = GameState::IN_PROGRESS;
+        winner = Player::NONE;
+    }
+
+    Player getCell(uint8_t row, uint8_t col) const {
+        if (row >= Rows || col >= Cols) {
+            return Player::NONE;
+        }
+        Bits bit = bottomMask(col) << row;
+        if (!(occupied & bit)) {
+            return Player::NONE;
+        }
+        return (firstStones & bit) ? Player::FIRST : Player::SECOND;
+    }
+
+    // Stones of the given player as a bitmask
+    Bits getStones(Player player) const {
+        if (player == Player::FIRST) return firstStones;
+        if (player == Player::SECOND) return occupied ^ firstStones;
+        return 0;
+    }
+
+    Bits getOccupied() const {
+        return occupied;
+    }
+
+    // Number of bits set: the POPCNT instruction where the compiler has
+    // it, a branch-free bit count elsewhere (AVR, Xtensa)
+    static uint8_t popCount(uint64_t bits) {
+#if defined(__GNUC__)
+        return static_cast<uint8_t>(__builtin_popcountll(bits));
+#else
+        bits -= (bits >> 1) & UINT64_C(0x5555555555555555);
+        bits = (bits & UINT64_C(0x3333333333333333)) + ((bits >> 2) & UINT64_C(0x3333333333333333));
+        bits = (bits + (bits >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+        return static_cast<uint8_t>((bits * UINT64_C(0x0101010101010101)) >> 56);
+#endif
+    }
+
+#ifdef __SIZEOF_INT128__
+    static uint8_t popCount(unsigned __int128 bits) {
+        return popCount(static_cast<uint64_t>(bits)) + popCount(static_cast<uint64_t>(bits >> 64));
+    }
+#endif
+
+    // Cells of one column
+    static Bits columnMask(uint8_t col) {
+        return ((Bits(1) << Rows) - 1) << (col * COLUMN_BITS);
+    }
+
+    // Cells where a stone can be played now (one per non-full column)
+    Bits getPlayableCells() const {
+        return (occupied + BOTTOM_ROW) & BOARD_MASK;
+    }
+
+    // Empty cells (playable now or later) that would win for player
+    Bits getWinningCells(Player player) const {
+        return winningCells(getStones(player), BOARD_MASK & ~occupied);
+    }
+
+    // Winning cells of player after it plays col (a valid move), without
+    // playing it
+    Bits getWinningCellsAfter(Player player, uint8_t col) const {
+        Bits bit = bottomMask(col) << columnHeights[col];
+        return winningCells(getStones(player) | bit, BOARD_MASK & ~(occupied | bit));
+    }
+
+    // True if player can win with the next stone
+    bool canWinNext(Player player) const {
+        return (getWinningCells(player) & getPlayableCells()) != 0;
+    }
+
+    // Playable cells that do not let the opponent win on the next move:
+    // a forced block if the opponent threatens a playable cell, never a cell
+    // directly below an opponent winning cell. Zero if every move loses.
+    Bits getNonLosingCells(Player player) const {
+        Player opponent = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        Bits playable = getPlayableCells();
+        Bits opponentWins = getWinningCells(opponent);
+        Bits forced = playable & opponentWins;
+        if (forced) {
+            // Two threats at once cannot both be blocked
+            if (forced & (forced - 1)) return 0;
+            playable = forced;
+        }
+        return playable & ~(opponentWins >> 1);
+    }
+
+    // Unique key for the position (fits in KEY_BITS bits): on boards of
+    // more than 64 bits, a hash of it (collisions are possible, if very
+    // unlikely)
+    uint64_t getKey() const {
+        return hashKey(firstStones + occupied);
+    }
+
+    // Key of the left-right mirror image of the position
+    uint64_t getMirrorKey() const {
+        return hashKey(mirrorFirst + mirrorOccupied);
+    }
+
+    // Same key for a position and its mirror image: that of the smaller of
+    // the two. Moves stored under it must go through mirrorColumn() if
+    // isMirrored().
+    uint64_t getCanonicalKey() const {
+        return hashKey(isMirrored() ? mirrorFirst + mirrorOccupied : firstStones + occupied);
+    }
+
+    // True if getCanonicalKey() is the key of the mirror image
+    bool isMirrored() const {
+        return mirrorFirst + mirrorOccupied < firstStones + occupied;
+    }
+
+    // True if the position is its own mirror image: moves in the right half
+    // of the board are equivalent to their mirror moves
+    bool isSymmetric() const {
+        return mirrorFirst + mirrorOccupied == firstStones + occupied;
+    }
+
+    static uint8_t mirrorColumn(uint8_t col) {
+        return Cols - 1 - col;
+    }
+
+    // Cells of the columns left of the center, center column included
+    static Bits leftHalfMask() {
+        return BOARD_MASK & ((Bits(1) << (COLUMN_BITS * ((Cols + 1) / 2))) - 1);
+    }
+
+    uint8_t getColumnHeight(uint8_t col) const {
+        return col < Cols ? columnHeights[col] : 0;
+    }
+
+    GameState getState() const {
+        return state;
+    }
+
+    Player getWinner() const {
+        return winner;
+    }
+
+    uint8_t getMoveCount() const {
+        return moveCount;
+    }
+
+    bool isFull() const {
+        return moveCount >= Rows * Cols;
+    }
+
+    bool hasWinner() const {
+        return state == GameState::FIRST_WINS || state == GameState::SECOND_WINS;
+    }
+
+    bool isDraw() const {
+        return state == GameState::DRAW;
+    }
+
+    bool isGameOver() const {
+        return state != GameState::IN_PROGRESS;
+    }
+};
+
+typedef BasicConnect4BitBoard<> Connect4BitBoard;
+
+#endif // CONNECT4_BITBOARD_H
@@ -3,7 +3,7 @@
 
 #include <stdint.h>
 
-// Constants
+// Standard board geometry (other geometries: see BasicConnect4Board)
 constexpr uint8_t BOARD_ROWS = 6;
 constexpr uint8_t BOARD_COLS = 7;
 constexpr uint8_t CONNECT_WIN = 4;
@@ -21,10 +21,14 @@ enum class GameState : uint8_t {
     DRAW
 };
 
-class Connect4Board {
+// Array-backed board of Rows x Cols cells where Win stones in a row win.
+// Variants (8x7, Connect-5...) are separate instantiations, so every
+// dimension is a compile-time constant.
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+class BasicConnect4Board {
 private:
-    uint8_t board[BOARD_ROWS][BOARD_COLS];
-    uint8_t columnHeights[BOARD_COLS];
+    uint8_t board[Rows][Cols];
+    uint8_t columnHeights[Cols];
     uint8_t moveCount;
     GameState state;
     Player winner;
@@ -36,48 +40,48 @@ private:
         // Check left
         for (int c = col - 1; c >= 0 && board[row][c] == static_cast<uint8_t>(player); c--) count++;
         // Check right
-        for (int c = col + 1; c < BOARD_COLS && board[row][c] == static_cast<uint8_t>(player); c++) count++;
-        if (count >= CONNECT_WIN) return true;
+        for (int c = col + 1; c < Cols && board[row][c] == static_cast<uint8_t>(player); c++) count++;
+        if (count >= Win) return true;
 
         // Vertical
         count = 1;
         // Check down
-        for (int r = row + 1; r < BOARD_ROWS && board[r][col] == static_cast<uint8_t>(player); r++) count++;
+        for (int r = row + 1; r < Rows && board[r][col] == static_cast<uint8_t>(player); r++) count++;
         // Check up
         for (int r = row - 1; r >= 0 && board[r][col] == static_cast<uint8_t>(player); r--) count++;
-        if (count >= CONNECT_WIN) return true;
+        if (count >= Win) return true;
 
         // Diagonal (/)
         count = 1;
         // Check down-left
-        for (int r = row + 1, c = col - 1; r < BOARD_ROWS && c >= 0 && board[r][c] == static_cast<uint8_t>(player); r++, c--) count++;
+        for (int r = row + 1, c = col - 1; r < Rows && c >= 0 && board[r][c] == static_cast<uint8_t>(player); r++, c--) count++;
         // Check up-right
-        for (int r = row - 1, c = col + 1; r >= 0 && c < BOARD_COLS && board[r][c] == static_cast<uint8_t>(player); r--, c++) count++;
-        if (count >= CONNECT_WIN) return true;
+        for (int r = row - 1, c = col + 1; r >= 0 && c < Cols && board[r][c] == static_cast<uint8_t>(player); r--, c++) count++;
+        if (count >= Win) return true;
 
         // Diagonal (\)
         count = 1;
         // Check down-right
-        for (int r = row + 1, c = col + 1; r < BOARD_ROWS && c < BOARD_COLS && board[r][c] == static_cast<uint8_t>(player); r++, c++) count++;
+        for (int r = row + 1, c = col + 1; r < Rows && c < Cols && board[r][c] == static_cast<uint8_t>(player); r++, c++) count++;
         // Check up-left
         for (int r = row - 1, c = col - 1; r >= 0 && c >= 0 && board[r][c] == static_cast<uint8_t>(player); r--, c--) count++;
-        if (count >= CONNECT_WIN) return true;
+        if (count >= Win) return true;
 
         return false;
     }
 
 public:
-    Connect4Board() {
+    BasicConnect4Board() {
         reset();
     }
 
     void reset() {
-        for (uint8_t r = 0; r < BOARD_ROWS; r++) {
-            for (uint8_t c = 0; c < BOARD_COLS; c++) {
+        for (uint8_t r = 0; r < Rows; r++) {
+            for (uint8_t c = 0; c < Cols; c++) {
                 board[r][c] = static_cast<uint8_t>(Player::NONE);
             }
         }
-        for (uint8_t c = 0; c < BOARD_COLS; c++) {
+        for (uint8_t c = 0; c < Cols; c++) {
             columnHeights[c] = 0;
         }
         moveCount = 0;
@@ -86,7 +90,7 @@ public:
     }
 
     bool isValidMove(uint8_t col) const {
-        return col < BOARD_COLS && columnHeights[col] < BOARD_ROWS;
+        return col < Cols && columnHeights[col] < Rows;
     }
 
     bool makeMove(uint8_t col, Player player) {
@@ -105,7 +109,7 @@ public:
             winner = player;
         }
         // Check for draw
-        else if (moveCount >= BOARD_ROWS * BOARD_COLS) {
+        else if (moveCount >= Rows * Cols) {
             state = GameState::DRAW;
         }
 
@@ -113,7 +117,7 @@ public:
     }
 
     void undoMove(uint8_t col) {
-        if (col >= BOARD_COLS || columnHeights[col] == 0) {
+        if (col >= Cols || columnHeights[col] == 0) {
             return;
         }
 
@@ -126,14 +130,14 @@ public:
     }
 
     Player getCell(uint8_t row, uint8_t col) const {
-        if (row >= BOARD_ROWS || col >= BOARD_COLS) {
+        if (row >= Rows || col >= Cols) {
             return Player::NONE;
         }
         return static_cast<Player>(board[row][col]);
     }
 
     uint8_t getColumnHeight(uint8_t col) const {
-        return col < BOARD_COLS ? columnHeights[col] : 0;
+        return col < Cols ? columnHeights[col] : 0;
     }
 
     GameState getState() const {
@@ -149,7 +153,7 @@ public:
     }
 
     bool isFull() const {
-        return moveCount >= BOARD_ROWS * BOARD_COLS;
+        return moveCount >= Rows * Cols;
     }
 
     bool hasWinner() const {
@@ -165,4 +169,7 @@ public:
     }
 };
 
+// The standard 6x7 board, connect 4
+typedef BasicConnect4Board<> Connect4Board;
+
 #endif // CONNECT4_BOARD_H
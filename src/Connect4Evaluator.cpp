@@ -0,0 +1,3 @@
+#include "Connect4Evaluator.h"
+
+template class BasicConnect4Evaluator<>;
@@ -0,0 +1,189 @@
+#ifndef CONNECT4_EVALUATOR_H
+#define CONNECT4_EVALUATOR_H
+
+#include "Connect4BitBoard.h"
+#include <stdint.h>
+
+// How the evaluation is computed. Enabled by default except on 8-bit AVR,
+// where 64-bit arithmetic is slow; disable to keep per-window counts.
+#ifndef CONNECT4_EVAL_BITBOARD
+#ifdef __AVR__
+#define CONNECT4_EVAL_BITBOARD 0
+#else
+#define CONNECT4_EVAL_BITBOARD 1
+#endif
+#endif
+
+// Default evaluation weights (see Connect4EvalWeights). tools/connect4_tune
+// fits them to solved positions and prints the result in this form, to be
+// passed with -D or defined before including the library.
+#ifndef CONNECT4_THREE_SCORE
+#define CONNECT4_THREE_SCORE 100
+#endif
+#ifndef CONNECT4_TWO_SCORE
+#define CONNECT4_TWO_SCORE 10
+#endif
+#ifndef CONNECT4_OPPONENT_THREE_SCORE
+#define CONNECT4_OPPONENT_THREE_SCORE (2 * CONNECT4_THREE_SCORE)
+#endif
+#ifndef CONNECT4_OPPONENT_TWO_SCORE
+#define CONNECT4_OPPONENT_TWO_SCORE CONNECT4_TWO_SCORE
+#endif
+#ifndef CONNECT4_CENTER_SCORE
+#define CONNECT4_CENTER_SCORE 3
+#endif
+
+// Weights of the heuristic evaluation. A window counts when it holds only
+// stones of one player; keep each weight below WIN_SCORE / (4 * Rows * Cols)
+// so that heuristic scores stay below forced results.
+struct Connect4EvalWeights {
+    int32_t three;          // Own window one stone short of a win
+    int32_t two;            // Own window two stones short
+    int32_t opponentThree;  // Subtracted for each opponent's window...
+    int32_t opponentTwo;
+    int32_t center;         // Per own stone in the center column
+};
+
+// Heuristic evaluation kept up to date move by move.
+//
+// The score sums every Win-cell window of the board (69 on a 6x7 board) plus
+// a bonus for center column stones.
+//
+// With CONNECT4_EVAL_BITBOARD, the evaluator keeps the stones of both
+// players as bitboards and scores all windows of a direction at once: their
+// stone counts are added up in bit-sliced form (one word per count bit),
+// and each kind of window is counted with a popcount. A move costs two bit
+// operations and a score about a hundred word operations.
+//
+// Otherwise a move only touches the (at most 16) windows through its cell,
+// so addStone/removeStone update the per-window piece counts and the
+// running score of both players, and reading the evaluation is constant
+// time.
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+class BasicConnect4Evaluator {
+    static_assert(Win < 16, "Window counts are packed in nibbles");
+
+public:
+    typedef BasicConnect4BitBoard<Rows, Cols, Win> BitBoard;
+
+    // Score of a completed window: also the threshold of forced results in
+    // the search, so it is not a tunable weight
+    static constexpr int32_t WIN_SCORE = 100000;
+
+    // Default weights
+    static constexpr int32_t THREE_SCORE = CONNECT4_THREE_SCORE;
+    static constexpr int32_t TWO_SCORE = CONNECT4_TWO_SCORE;
+    static constexpr int32_t OPPONENT_THREE_SCORE = CONNECT4_OPPONENT_THREE_SCORE;
+    static constexpr int32_t OPPONENT_TWO_SCORE = CONNECT4_OPPONENT_TWO_SCORE;
+    static constexpr int32_t CENTER_SCORE = CONNECT4_CENTER_SCORE;
+
+    static Connect4EvalWeights defaultWeights() {
+        Connect4EvalWeights weights = {THREE_SCORE, TWO_SCORE, OPPONENT_THREE_SCORE, OPPONENT_TWO_SCORE,
+                                       CENTER_SCORE};
+        return weights;
+    }
+
+    BasicConnect4Evaluator() : weights(defaultWeights()) {
+        reset();
+    }
+
+    // Weights used from the next load() or reset()
+    void setWeights(const Connect4EvalWeights& newWeights) {
+        weights = newWeights;
+    }
+
+    const Connect4EvalWeights& getWeights() const {
+        return weights;
+    }
+
+    void reset();
+
+    // Rebuild counts and scores from a position
+    void load(const BitBoard& board);
+
+    // Call after a stone is placed / before it is removed at (row, col)
+    void addStone(uint8_t row, uint8_t col, Player player) {
+        update(row, col, player, 1);
+    }
+
+    void removeStone(uint8_t row, uint8_t col, Player player) {
+        update(row, col, player, -1);
+    }
+
+    // Evaluation of the current position from player's point of view
+    int32_t getScore(Player player) const {
+#if CONNECT4_EVAL_BITBOARD
+        return player == Player::SECOND ? evaluateStones(stones[1], stones[0], weights)
+                                        : evaluateStones(stones[0], stones[1], weights);
+#else
+        return player == Player::SECOND ? secondScore : firstScore;
+#endif
+    }
+
+    // Score of one window holding mine/theirs stones (the rest empty)
+    static int32_t evaluateWindow(uint8_t mine, uint8_t theirs,
+                                  const Connect4EvalWeights& weights = defaultWeights());
+
+    // Full rescan of a position, equal to getScore() after load() with the
+    // same weights
+    static int32_t evaluate(const BitBoard& board, Player player,
+                            const Connect4EvalWeights& weights = defaultWeights());
+
+private:
+    static constexpr uint8_t DIRECTIONS = 4;
+
+    // Bitboard layout (see BasicConnect4BitBoard): Rows + 1 bits per column
+    static constexpr uint8_t COLUMN_BITS = Rows + 1;
+    typedef typename BitBoard::Bits Bits;
+    static constexpr Bits BOARD_MASK = connect4BottomRow<Rows, Cols>() * ((Bits(1) << Rows) - 1);
+
+    // Bits of a window stone count (0 to Win)
+    static constexpr uint8_t COUNT_BITS = Win < 2 ? 1 : (Win < 4 ? 2 : (Win < 8 ? 3 : 4));
+
+    // Windows whose bit-sliced stone count equals n (bit i set for the
+    // window starting at cell i)
+    static Bits countEquals(const Bits counts[COUNT_BITS], uint8_t n);
+
+    // Sum of the window scores along one bitboard direction
+    static int32_t evaluateAlong(Bits mine, Bits theirs, uint8_t shift,
+                                 const Connect4EvalWeights& weights);
+
+    // Score of the stones mine against theirs
+    static int32_t evaluateStones(Bits mine, Bits theirs, const Connect4EvalWeights& weights);
+
+    // Window directions as (row, col) steps: horizontal, vertical,
+    // diagonal (/), diagonal (\)
+    static constexpr int8_t directionRow(uint8_t d) {
+        return d == 0 ? 0 : (d == 3 ? -1 : 1);
+    }
+
+    static constexpr int8_t directionCol(uint8_t d) {
+        return d == 1 ? 0 : 1;
+    }
+
+    static bool isOnBoard(int8_t row, int8_t col) {
+        return row >= 0 && row < Rows && col >= 0 && col < Cols;
+    }
+
+    Connect4EvalWeights weights;
+
+#if CONNECT4_EVAL_BITBOARD
+    Bits stones[2];   // Stones of FIRST and SECOND
+#else
+    // Piece counts per window, indexed by direction and start cell:
+    // low nibble = FIRST stones, high nibble = SECOND stones
+    uint8_t windowCounts[DIRECTIONS][Rows][Cols];
+    int32_t firstScore;
+    int32_t secondScore;
+#endif
+
+    void update(uint8_t row, uint8_t col, Player player, int8_t delta);
+};
+
+#include "Connect4EvaluatorImpl.h"
+
+// The standard board is compiled once, in Connect4Evaluator.cpp
+extern template class BasicConnect4Evaluator<>;
+typedef BasicConnect4Evaluator<> Connect4Evaluator;
+
+#endif // CONNECT4_EVALUATOR_H
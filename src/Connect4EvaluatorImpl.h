@@ -0,0 +1,176 @@
+#ifndef CONNECT4_EVALUATOR_IMPL_H
+#define CONNECT4_EVALUATOR_IMPL_H
+
+// Member definitions of BasicConnect4Evaluator, included by
+// Connect4Evaluator.h
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4Evaluator<Rows, Cols, Win>::evaluateWindow(uint8_t mine, uint8_t theirs,
+                                                                const Connect4EvalWeights& weights) {
+    int32_t score = 0;
+    uint8_t empty = Win - mine - theirs;
+
+    // Score based on window content
+    if (mine == Win) {
+        score += WIN_SCORE;
+    } else if (mine == Win - 1 && empty == 1) {
+        score += weights.three;
+    } else if (mine == Win - 2 && empty == 2) {
+        score += weights.two;
+    }
+
+    // Penalize opponent opportunities (threats heavily by default)
+    if (theirs == Win - 1 && empty == 1) {
+        score -= weights.opponentThree;
+    } else if (theirs == Win - 2 && empty == 2) {
+        score -= weights.opponentTwo;
+    }
+
+    return score;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Evaluator<Rows, Cols, Win>::reset() {
+#if CONNECT4_EVAL_BITBOARD
+    stones[0] = 0;
+    stones[1] = 0;
+#else
+    for (uint8_t d = 0; d < DIRECTIONS; d++) {
+        for (uint8_t r = 0; r < Rows; r++) {
+            for (uint8_t c = 0; c < Cols; c++) {
+                windowCounts[d][r][c] = 0;
+            }
+        }
+    }
+
+    // Every empty window scores zero for both players
+    firstScore = 0;
+    secondScore = 0;
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Evaluator<Rows, Cols, Win>::load(const BitBoard& board) {
+#if CONNECT4_EVAL_BITBOARD
+    stones[0] = board.getStones(Player::FIRST);
+    stones[1] = board.getStones(Player::SECOND);
+#else
+    reset();
+    for (uint8_t c = 0; c < Cols; c++) {
+        for (uint8_t r = 0; r < board.getColumnHeight(c); r++) {
+            addStone(r, c, board.getCell(r, c));
+        }
+    }
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Evaluator<Rows, Cols, Win>::update(uint8_t row, uint8_t col, Player player, int8_t delta) {
+#if CONNECT4_EVAL_BITBOARD
+    Bits bit = Bits(1) << (col * COLUMN_BITS + row);
+    Bits& playerStones = stones[player == Player::SECOND ? 1 : 0];
+    playerStones = (delta > 0) ? (playerStones | bit) : (playerStones & ~bit);
+#else
+    if (col == Cols / 2) {
+        int32_t center = weights.center * delta;
+        if (player == Player::FIRST) firstScore += center;
+        else secondScore += center;
+    }
+
+    uint8_t unit = (player == Player::FIRST) ? 0x01 : 0x10;
+
+    for (uint8_t d = 0; d < DIRECTIONS; d++) {
+        // Windows through (row, col) start 0 to Win - 1 steps behind it
+        for (uint8_t k = 0; k < Win; k++) {
+            int8_t startRow = row - k * directionRow(d);
+            int8_t startCol = col - k * directionCol(d);
+            int8_t endRow = startRow + (Win - 1) * directionRow(d);
+            int8_t endCol = startCol + (Win - 1) * directionCol(d);
+            if (!isOnBoard(startRow, startCol) || !isOnBoard(endRow, endCol)) continue;
+
+            uint8_t& counts = windowCounts[d][startRow][startCol];
+            uint8_t first = counts & 0x0F;
+            uint8_t second = counts >> 4;
+            firstScore -= evaluateWindow(first, second, weights);
+            secondScore -= evaluateWindow(second, first, weights);
+
+            counts = (delta > 0) ? counts + unit : counts - unit;
+
+            first = counts & 0x0F;
+            second = counts >> 4;
+            firstScore += evaluateWindow(first, second, weights);
+            secondScore += evaluateWindow(second, first, weights);
+        }
+    }
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+typename BasicConnect4Evaluator<Rows, Cols, Win>::Bits
+BasicConnect4Evaluator<Rows, Cols, Win>::countEquals(const Bits counts[COUNT_BITS], uint8_t n) {
+    Bits windows = ~Bits(0);
+    for (uint8_t b = 0; b < COUNT_BITS; b++) {
+        windows &= ((n >> b) & 1) ? counts[b] : ~counts[b];
+    }
+    return windows;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4Evaluator<Rows, Cols, Win>::evaluateAlong(Bits mine, Bits theirs, uint8_t shift,
+                                                               const Connect4EvalWeights& weights) {
+    // Windows lying on the board, by their first cell (the sentinel row
+    // keeps windows from wrapping into the next column)
+    Bits starts = BOARD_MASK;
+    for (uint8_t k = 1; k < Win; k++) {
+        starts &= BOARD_MASK >> (shift * k);
+    }
+
+    // Stone counts of all windows at once: bit i of mineCount[b] is bit b
+    // of the number of stones in the window starting at cell i
+    Bits mineCount[COUNT_BITS] = {};
+    Bits theirsCount[COUNT_BITS] = {};
+    for (uint8_t k = 0; k < Win; k++) {
+        Bits mineCarry = mine >> (shift * k);
+        Bits theirsCarry = theirs >> (shift * k);
+        for (uint8_t b = 0; b < COUNT_BITS; b++) {
+            Bits mineSum = mineCount[b] ^ mineCarry;
+            mineCarry &= mineCount[b];
+            mineCount[b] = mineSum;
+            Bits theirsSum = theirsCount[b] ^ theirsCarry;
+            theirsCarry &= theirsCount[b];
+            theirsCount[b] = theirsSum;
+        }
+    }
+
+    // The cases of evaluateWindow(): only windows of one colour score
+    Bits mineOnly = starts & countEquals(theirsCount, 0);
+    Bits theirsOnly = starts & countEquals(mineCount, 0);
+    return WIN_SCORE * BitBoard::popCount(mineOnly & countEquals(mineCount, Win)) +
+           weights.three * BitBoard::popCount(mineOnly & countEquals(mineCount, Win - 1)) +
+           weights.two * BitBoard::popCount(mineOnly & countEquals(mineCount, Win - 2)) -
+           weights.opponentThree * BitBoard::popCount(theirsOnly & countEquals(theirsCount, Win - 1)) -
+           weights.opponentTwo * BitBoard::popCount(theirsOnly & countEquals(theirsCount, Win - 2));
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4Evaluator<Rows, Cols, Win>::evaluateStones(Bits mine, Bits theirs,
+                                                                const Connect4EvalWeights& weights) {
+    // Center column (strategic advantage)
+    int32_t score = weights.center * BitBoard::popCount(mine & BitBoard::columnMask(Cols / 2));
+
+    // Directions spelled out so each call is unrolled with a constant shift
+    score += evaluateAlong(mine, theirs, 1, weights);                  // Vertical
+    score += evaluateAlong(mine, theirs, COLUMN_BITS, weights);        // Horizontal
+    score += evaluateAlong(mine, theirs, COLUMN_BITS - 1, weights);    // Diagonal (\)
+    score += evaluateAlong(mine, theirs, COLUMN_BITS + 1, weights);    // Diagonal (/)
+    return score;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int32_t BasicConnect4Evaluator<Rows, Cols, Win>::evaluate(const BitBoard& board, Player player,
+                                                          const Connect4EvalWeights& weights) {
+    Player opponent = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    return evaluateStones(board.getStones(player), board.getStones(opponent), weights);
+}
+
+#endif // CONNECT4_EVALUATOR_IMPL_H
@@ -0,0 +1,55 @@
+#ifndef CONNECT4_FOOTPRINT_H
+#define CONNECT4_FOOTPRINT_H
+
+#include "Connect4.h"
+#include "Connect4Search.h"
+#include <stddef.h>
+
+// Stack used by the search per ply of depth. The measured use of a search
+// is in SearchStats::stackBytes (about 200 bytes per ply on x86-64 with
+// -O2, less on 32-bit targets); set this to the value measured on the
+// target for an exact report.
+#ifndef CONNECT4_STACK_PER_PLY
+#define CONNECT4_STACK_PER_PLY 256
+#endif
+
+// RAM used by the engine, known at compile time. Nothing is allocated on
+// the heap without CONNECT4_THREADS: the shared table is static, a game and
+// its AI are plain objects, and the search recursion is bounded by
+// CONNECT4_MAX_PLY.
+//
+//   #define CONNECT4_RAM_BUDGET 200000   // Before including this header:
+//   #include "Connect4Footprint.h"       // the build fails if it does not fit
+//
+// tools/connect4_footprint.cpp prints these values and the stack measured
+// by a few searches.
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+struct BasicConnect4Footprint {
+    // Shared transposition table (static storage)
+    static constexpr size_t TABLE = sizeof(Connect4TTSlot) << CONNECT4_TT_SIZE_BITS;
+
+    // A game object, with its board and AI
+    static constexpr size_t GAME = sizeof(BasicConnect4<Rows, Cols, Win>);
+
+    // An AI alone (e.g. Connect4SessionManager workers, batch analysis)
+    static constexpr size_t AI = sizeof(BasicConnect4AI<Rows, Cols, Win>);
+
+    // A resumable search (no recursion: its stack is in the object)
+    static constexpr size_t SEARCH = sizeof(BasicConnect4Search<Rows, Cols, Win>);
+
+    // Deepest recursion of the search, and its stack estimate
+    static constexpr uint8_t MAX_PLY = BasicConnect4AI<Rows, Cols, Win>::MAX_PLY;
+    static constexpr size_t STACK = static_cast<size_t>(MAX_PLY + 1) * CONNECT4_STACK_PER_PLY;
+
+    // A game searching with the shared table
+    static constexpr size_t TOTAL = TABLE + GAME + STACK;
+};
+
+typedef BasicConnect4Footprint<> Connect4Footprint;
+
+#ifdef CONNECT4_RAM_BUDGET
+static_assert(Connect4Footprint::TOTAL <= CONNECT4_RAM_BUDGET,
+              "Connect4 does not fit CONNECT4_RAM_BUDGET: lower CONNECT4_TT_SIZE_BITS or CONNECT4_MAX_PLY");
+#endif
+
+#endif // CONNECT4_FOOTPRINT_H
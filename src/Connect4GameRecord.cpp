@@ -0,0 +1,192 @@
+#include "Connect4GameRecord.h"
+#include <string.h>
+
+namespace {
+
+const char* const RESULT_TEXT[4] = {"*", "1-0", "0-1", "1/2-1/2"};
+
+const char* skipSpaces(const char* c) {
+    while (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n') c++;
+    return c;
+}
+
+// Scores as zigzag varints: 7 bits per byte, small magnitudes first
+uint8_t* writeVarint(uint8_t* out, int32_t value) {
+    uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(-(value < 0 ? 1 : 0));
+    while (zigzag >= 0x80) {
+        *out++ = static_cast<uint8_t>(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(zigzag);
+    return out;
+}
+
+uint8_t varintSize(int32_t value) {
+    uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(-(value < 0 ? 1 : 0));
+    uint8_t bytes = 1;
+    while (zigzag >= 0x80) {
+        zigzag >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+} // namespace
+
+bool Connect4GameRecord::parse(const char* text) {
+    clear();
+    const char* c = text;
+    for (; *c >= '1' && *c <= '8'; c++) {
+        if (!addMove(static_cast<uint8_t>(*c - '1'))) return false;
+    }
+    c = skipSpaces(c);
+    if (*c == '\0') return true;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        size_t length = strlen(RESULT_TEXT[i]);
+        if (strncmp(c, RESULT_TEXT[i], length) == 0) {
+            if (*skipSpaces(c + length) != '\0') return false;
+            result = static_cast<GameState>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t Connect4GameRecord::format(char* out, size_t size) const {
+    const char* resultText = RESULT_TEXT[static_cast<uint8_t>(result) & 0x03];
+    size_t length = moveCount + (moveCount > 0 ? 1 : 0) + strlen(resultText);
+    if (length + 1 > size) return 0;
+
+    char* c = out;
+    for (uint8_t i = 0; i < moveCount; i++) {
+        *c++ = static_cast<char>('1' + moves[i]);
+    }
+    if (moveCount > 0) *c++ = ' ';
+    strcpy(c, resultText);
+    return length;
+}
+
+size_t Connect4GameWriter::recordSize(const Connect4GameRecord& record) {
+    size_t bytes = 2 + (record.moveCount * 3 + 7) / 8;
+    if (record.hasScores) {
+        for (uint8_t i = 0; i < record.moveCount; i++) {
+            bytes += varintSize(record.scores[i]);
+        }
+    }
+    return bytes;
+}
+
+bool Connect4GameWriter::write(const Connect4GameRecord& record) {
+    if (record.moveCount > Connect4GameRecord::MAX_MOVES ||
+        recordSize(record) > capacity - size) {
+        return false;
+    }
+
+    uint8_t* out = buffer + size;
+    *out++ = record.moveCount;
+    *out++ = static_cast<uint8_t>(static_cast<uint8_t>(record.result) & 0x03) |
+             (record.hasScores ? Connect4GameRecord::HAS_SCORES : 0);
+
+    // Pack the moves through a bit accumulator, a byte out every 8 bits
+    uint32_t bits = 0;
+    uint8_t bitCount = 0;
+    for (uint8_t i = 0; i < record.moveCount; i++) {
+        bits |= static_cast<uint32_t>(record.moves[i] & 0x07) << bitCount;
+        bitCount += 3;
+        if (bitCount >= 8) {
+            *out++ = static_cast<uint8_t>(bits);
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    }
+    if (bitCount > 0) *out++ = static_cast<uint8_t>(bits);
+
+    if (record.hasScores) {
+        for (uint8_t i = 0; i < record.moveCount; i++) {
+            out = writeVarint(out, record.scores[i]);
+        }
+    }
+
+    size = out - buffer;
+    return true;
+}
+
+void Connect4GameWriter::writeHeader(uint8_t out[Connect4GameRecord::HEADER_SIZE],
+                                     uint8_t rows, uint8_t cols, uint8_t win) {
+    out[0] = 'C';
+    out[1] = '4';
+    out[2] = 'G';
+    out[3] = 'R';
+    out[4] = Connect4GameRecord::VERSION;
+    out[5] = rows;
+    out[6] = cols;
+    out[7] = win;
+}
+
+bool Connect4GameReader::readHeader(const uint8_t* bytes, size_t length,
+                                    uint8_t& rows, uint8_t& cols, uint8_t& win) {
+    if (bytes == nullptr || length < Connect4GameRecord::HEADER_SIZE) {
+        return false;
+    }
+    if (bytes[0] != 'C' || bytes[1] != '4' || bytes[2] != 'G' || bytes[3] != 'R' ||
+        bytes[4] != Connect4GameRecord::VERSION) {
+        return false;
+    }
+    rows = bytes[5];
+    cols = bytes[6];
+    win = bytes[7];
+    return true;
+}
+
+Connect4ReadStatus Connect4GameReader::next(Connect4GameRecord& record) {
+    // Nothing is consumed until the whole record is known to be there
+    const uint8_t* in = data + offset;
+    const uint8_t* end = data + size;
+    if (end - in < 2) return Connect4ReadStatus::NEED_MORE;
+
+    uint8_t moveCount = in[0];
+    uint8_t flags = in[1];
+    if (moveCount > Connect4GameRecord::MAX_MOVES ||
+        (flags & ~(0x03 | Connect4GameRecord::HAS_SCORES)) != 0) {
+        return Connect4ReadStatus::INVALID;
+    }
+    size_t moveBytes = (moveCount * 3 + 7) / 8;
+    if (static_cast<size_t>(end - in) < 2 + moveBytes) return Connect4ReadStatus::NEED_MORE;
+    in += 2;
+
+    record.moveCount = moveCount;
+    record.result = static_cast<GameState>(flags & 0x03);
+    record.hasScores = (flags & Connect4GameRecord::HAS_SCORES) != 0;
+
+    uint32_t bits = 0;
+    uint8_t bitCount = 0;
+    for (uint8_t i = 0; i < moveCount; i++) {
+        if (bitCount < 3) {
+            bits |= static_cast<uint32_t>(*in++) << bitCount;
+            bitCount += 8;
+        }
+        record.moves[i] = static_cast<uint8_t>(bits & 0x07);
+        bits >>= 3;
+        bitCount -= 3;
+    }
+
+    if (record.hasScores) {
+        for (uint8_t i = 0; i < moveCount; i++) {
+            uint32_t zigzag = 0;
+            uint8_t shift = 0;
+            for (;;) {
+                if (in == end) return Connect4ReadStatus::NEED_MORE;
+                if (shift > 28) return Connect4ReadStatus::INVALID;
+                uint8_t byte = *in++;
+                zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) break;
+                shift += 7;
+            }
+            record.scores[i] = static_cast<int32_t>((zigzag >> 1) ^ (0 - (zigzag & 1)));
+        }
+    }
+
+    offset = in - data;
+    return Connect4ReadStatus::OK;
+}
@@ -0,0 +1,163 @@
+#ifndef CONNECT4_GAME_RECORD_H
+#define CONNECT4_GAME_RECORD_H
+
+#include "Connect4Board.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// One game: its moves, its result and optionally a score per move.
+//
+// Binary format (little-endian, see Connect4GameWriter/Connect4GameReader):
+//   file header 8 bytes: 'C' '4' 'G' 'R', version, rows, columns, alignment
+//   records, each:
+//     1 byte   move count
+//     1 byte   result (GameState, bits 0-1) | HAS_SCORES (bit 2)
+//     moves    3 bits per column, least significant bits first, padded to
+//              a whole byte (a 42-move game takes 16 bytes)
+//     scores   if HAS_SCORES: one zigzag varint per move (1-2 bytes for
+//              heuristic scores, 3 for wins)
+//
+// Text form: the columns as digits 1-8, then a space and the result:
+// "4453 1-0", "0-1", "1/2-1/2" or "*" (unfinished).
+//
+// Records have a fixed size and are meant to be reused: reading, writing and
+// replaying games never allocate.
+struct Connect4GameRecord {
+    static constexpr uint8_t HEADER_SIZE = 8;
+    static constexpr uint8_t VERSION = 1;
+    static constexpr uint8_t MAX_MOVES = 64;     // Boards of up to 64 cells (9x7, 8x8)
+    static constexpr uint8_t HAS_SCORES = 0x04;
+    static constexpr uint16_t MAX_RECORD_SIZE = 2 + (MAX_MOVES * 3 + 7) / 8 + MAX_MOVES * 5;
+    static constexpr uint8_t MAX_TEXT_SIZE = MAX_MOVES + 9;  // Moves, result and '\0'
+
+    uint8_t moveCount;
+    GameState result;
+    bool hasScores;
+    uint8_t moves[MAX_MOVES];    // Columns 0-7, FIRST plays the even moves
+    int32_t scores[MAX_MOVES];   // Score of each move, if hasScores
+
+    Connect4GameRecord() {
+        clear();
+    }
+
+    void clear() {
+        moveCount = 0;
+        result = GameState::IN_PROGRESS;
+        hasScores = false;
+    }
+
+    // Append a move; false if the record is full or the column is over 7
+    bool addMove(uint8_t column) {
+        if (moveCount >= MAX_MOVES || column > 7) return false;
+        scores[moveCount] = 0;
+        moves[moveCount++] = column;
+        return true;
+    }
+
+    bool addMove(uint8_t column, int32_t score) {
+        if (!addMove(column)) return false;
+        scores[moveCount - 1] = score;
+        hasScores = true;
+        return true;
+    }
+
+    // Play the moves on a board (Connect4Board or Connect4BitBoard of any
+    // geometry), from the empty board. Returns false on an illegal move or
+    // if the record's result is not the one reached on the board.
+    template <typename Board>
+    bool replay(Board& board) const {
+        board.reset();
+        Player player = Player::FIRST;
+        for (uint8_t i = 0; i < moveCount; i++) {
+            if (!board.makeMove(moves[i], player)) return false;
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+        return result == GameState::IN_PROGRESS || board.getState() == result;
+    }
+
+    // Text form. parse() returns false (and leaves a partial record) on a
+    // malformed string; format() returns the length written, 0 if out is too
+    // small (MAX_TEXT_SIZE is always enough).
+    bool parse(const char* text);
+    size_t format(char* out, size_t size) const;
+};
+
+enum class Connect4ReadStatus : uint8_t {
+    OK,          // A record was read
+    NEED_MORE,   // The data ends inside a record (or at its end)
+    INVALID      // Corrupt data: the rest of the stream cannot be trusted
+};
+
+// Appends binary records to a caller-provided buffer. When write() returns
+// false the buffer is full: flush getData()/getSize() and clear().
+class Connect4GameWriter {
+public:
+    Connect4GameWriter(uint8_t* buffer, size_t capacity)
+        : buffer(buffer), capacity(capacity), size(0) {}
+
+    bool write(const Connect4GameRecord& record);
+
+    const uint8_t* getData() const {
+        return buffer;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+    void clear() {
+        size = 0;
+    }
+
+    // Bytes taken by the record in the binary format
+    static size_t recordSize(const Connect4GameRecord& record);
+
+    static void writeHeader(uint8_t out[Connect4GameRecord::HEADER_SIZE],
+                            uint8_t rows = BOARD_ROWS, uint8_t cols = BOARD_COLS,
+                            uint8_t win = CONNECT_WIN);
+
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t size;
+};
+
+// Reads binary records from a buffer filled by the caller, without copying.
+// To stream a file, read a block and call next() until NEED_MORE, then move
+// the getRemaining() unread bytes to the front of the block, fill the rest
+// and setData() again.
+class Connect4GameReader {
+public:
+    Connect4GameReader() : data(nullptr), size(0), offset(0) {}
+
+    Connect4GameReader(const uint8_t* data, size_t size) : data(data), size(size), offset(0) {}
+
+    void setData(const uint8_t* bytes, size_t length) {
+        data = bytes;
+        size = length;
+        offset = 0;
+    }
+
+    // Read the next record (only valid when OK is returned)
+    Connect4ReadStatus next(Connect4GameRecord& record);
+
+    // Bytes read so far / bytes left after the last complete record
+    size_t getOffset() const {
+        return offset;
+    }
+
+    size_t getRemaining() const {
+        return size - offset;
+    }
+
+    // Check a file header; fills the board geometry it was written for
+    static bool readHeader(const uint8_t* bytes, size_t length,
+                           uint8_t& rows, uint8_t& cols, uint8_t& win);
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+};
+
+#endif // CONNECT4_GAME_RECORD_H
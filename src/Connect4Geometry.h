@@ -0,0 +1,73 @@
+#ifndef CONNECT4_GEOMETRY_H
+#define CONNECT4_GEOMETRY_H
+
+#include <stdint.h>
+
+// Compile-time helpers for the board templates (BasicConnect4Board and
+// friends are parameterized on rows, columns and stones in a row).
+
+// i-th column when going from the center outwards: 3 2 4 1 5 0 6 on 7
+// columns, 4 3 5 2 6 1 7 0 on 8
+template <uint8_t Cols>
+constexpr uint8_t connect4CenterColumn(uint8_t i) {
+    return (i & 1) ? Cols / 2 - (i + 1) / 2 : Cols / 2 + i / 2;
+}
+
+// Largest bitboard: boards of more than 64 bits use the compiler's 128-bit
+// integers where it has them (GCC and Clang on 64-bit targets)
+#ifdef __SIZEOF_INT128__
+constexpr uint8_t MAX_BITBOARD_BITS = 128;
+#else
+constexpr uint8_t MAX_BITBOARD_BITS = 64;
+#endif
+
+template <bool Wide>
+struct Connect4BitsType {
+    typedef uint64_t type;
+};
+
+#ifdef __SIZEOF_INT128__
+template <>
+struct Connect4BitsType<true> {
+    typedef unsigned __int128 type;
+};
+#endif
+
+// Integer holding a bitboard of Rows + 1 bits per column (see
+// BasicConnect4BitBoard): uint64_t whenever the board fits
+template <uint8_t Rows, uint8_t Cols>
+using Connect4Bits = typename Connect4BitsType<((Rows + 1) * Cols > 64)>::type;
+
+// Bitboard cells of the bottom row, from col onwards, with Rows + 1 bits
+// per column (see BasicConnect4BitBoard)
+template <uint8_t Rows, uint8_t Cols>
+constexpr Connect4Bits<Rows, Cols> connect4BottomRow(uint8_t col = 0) {
+    return col >= Cols ? 0 : (Connect4Bits<Rows, Cols>(1) << (col * (Rows + 1))) |
+                                 connect4BottomRow<Rows, Cols>(col + 1);
+}
+
+// Index pack 0..N-1 (std::index_sequence is C++14)
+template <uint8_t... I>
+struct Connect4Indices {};
+
+template <uint8_t N, uint8_t... I>
+struct Connect4MakeIndices : Connect4MakeIndices<N - 1, N - 1, I...> {};
+
+template <uint8_t... I>
+struct Connect4MakeIndices<0, I...> {
+    typedef Connect4Indices<I...> type;
+};
+
+// Center-out column order as a constant table
+template <uint8_t Cols, typename Indices = typename Connect4MakeIndices<Cols>::type>
+struct Connect4CenterOrder;
+
+template <uint8_t Cols, uint8_t... I>
+struct Connect4CenterOrder<Cols, Connect4Indices<I...> > {
+    static constexpr uint8_t columns[Cols] = {connect4CenterColumn<Cols>(I)...};
+};
+
+template <uint8_t Cols, uint8_t... I>
+constexpr uint8_t Connect4CenterOrder<Cols, Connect4Indices<I...> >::columns[Cols];
+
+#endif // CONNECT4_GEOMETRY_H
@@ -0,0 +1,420 @@
+#ifndef CONNECT4_IMPL_H
+#define CONNECT4_IMPL_H
+
+// Member definitions of BasicConnect4, included by Connect4.h
+
+// For printBoard() - Arduino compatibility
+#ifdef ARDUINO
+#include <Arduino.h>
+#define CONNECT4_PRINT(x) Serial.print(x)
+#define CONNECT4_PRINTLN(x) Serial.println(x)
+#else
+#include <iostream>
+#define CONNECT4_PRINT(x) std::cout << x
+#define CONNECT4_PRINTLN(x) std::cout << x << std::endl
+#endif
+
+#if CONNECT4_THREADS
+#include <chrono>
+#endif
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+BasicConnect4<Rows, Cols, Win>::BasicConnect4()
+#if CONNECT4_THREADS
+    : ponderPlayer(Player::NONE), ponderDepth(0), ponderReply(-1), ponderMove(-1),
+      ponderState(PonderState::IDLE), ponderEnabled(false), ponderHits(0),
+      ponderStop(false), ponderDone(false),
+      lastAIMove(-1), lastAIPlayer(Player::NONE), lastAIDepth(0)
+#endif
+{
+}
+
+#if CONNECT4_THREADS
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+BasicConnect4<Rows, Cols, Win>::BasicConnect4(const BasicConnect4& other)
+    : board(other.board), ai(other.ai),
+      ponderPlayer(Player::NONE), ponderDepth(0), ponderReply(-1), ponderMove(-1),
+      ponderState(PonderState::IDLE), ponderEnabled(other.ponderEnabled), ponderHits(0),
+      ponderStop(false), ponderDone(false),
+      lastAIMove(other.lastAIMove), lastAIPlayer(other.lastAIPlayer), lastAIDepth(other.lastAIDepth) {
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+BasicConnect4<Rows, Cols, Win>& BasicConnect4<Rows, Cols, Win>::operator=(const BasicConnect4& other) {
+    if (this != &other) {
+        stopPondering();
+        board = other.board;
+        ai = other.ai;
+        ponderEnabled = other.ponderEnabled;
+        lastAIMove = other.lastAIMove;
+        lastAIPlayer = other.lastAIPlayer;
+        lastAIDepth = other.lastAIDepth;
+    }
+    return *this;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+BasicConnect4<Rows, Cols, Win>::~BasicConnect4() {
+    stopPondering();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::startPondering() {
+    ponderReply = ai.getExpectedReply();
+    Player opponent = getOpponent(lastAIPlayer);
+    if (ponderReply < 0 || !board.isValidMove(static_cast<uint8_t>(ponderReply))) return;
+    
+    ponderBoard = BitBoard(board);
+    ponderBoard.makeMove(static_cast<uint8_t>(ponderReply), opponent);
+    if (ponderBoard.isGameOver()) return;
+    
+    // The copy keeps ai's settings, and its table is the same one: what
+    // the background search stores helps the next search even on a miss
+    ponderAI = ai;
+    ponderAI.setStopFlag(&ponderStop);
+    ponderPlayer = lastAIPlayer;
+    ponderDepth = lastAIDepth;
+    ponderMove = -1;
+    ponderStop.store(false);
+    ponderDone.store(false);
+    ponderState = PonderState::WAITING;
+    ponderStart = std::chrono::steady_clock::now();
+    ponderThread = std::thread([this]() {
+        ponderMove = ponderDepth > 0 ? ponderAI.calculateBestMove(ponderBoard, ponderPlayer, ponderDepth)
+                                     : ponderAI.calculateBestMoveTimed(ponderBoard, ponderPlayer, UINT32_MAX);
+        ponderDone.store(true);
+    });
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::stopPondering() {
+    if (ponderState == PonderState::IDLE) return;
+    ponderStop.store(true);
+    ponderThread.join();
+    ponderState = PonderState::IDLE;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::updatePondering(uint8_t column, Player player) {
+    if (ponderState == PonderState::WAITING && player != ponderPlayer && column == ponderReply) {
+        ponderState = PonderState::HIT;
+        return;
+    }
+    stopPondering();
+    
+    if (ponderEnabled && player == lastAIPlayer && column == lastAIMove && !board.isGameOver()) {
+        startPondering();
+    }
+    lastAIMove = -1;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+int8_t BasicConnect4<Rows, Cols, Win>::takePonderMove(Player player, uint8_t depth, uint32_t maxMillis) {
+    if (ponderState != PonderState::HIT || player != ponderPlayer || depth != ponderDepth) {
+        stopPondering();
+        return -1;
+    }
+    
+    // A timed search runs until stopped. It has searched this position
+    // since pondering started: give it what is left of this move's budget
+    if (depth == 0) {
+        std::chrono::steady_clock::time_point deadline = ponderStart + std::chrono::milliseconds(maxMillis);
+        while (!ponderDone.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ponderStop.store(true);
+    }
+    ponderThread.join();
+    ponderState = PonderState::IDLE;
+    if (ponderMove < 0) return -1;
+    
+    // Continue from the ponder search: its score and principal variation
+    ai = ponderAI;
+    ai.setStopFlag(nullptr);
+    ponderHits++;
+    return ponderMove;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::recordAIMove(int8_t move, Player player, uint8_t depth) {
+    lastAIMove = move;
+    lastAIPlayer = player;
+    lastAIDepth = depth;
+}
+#endif
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::reset() {
+#if CONNECT4_THREADS
+    stopPondering();
+    lastAIMove = -1;
+#endif
+    board.reset();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4<Rows, Cols, Win>::playMoveInternal(uint8_t column, Player player) {
+    // Internal method using 0-based indexing
+    if (player == Player::NONE) {
+        return false;
+    }
+    return board.makeMove(column, player);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4<Rows, Cols, Win>::playMove(uint8_t column, Player player) {
+    // User-facing method: convert from 1-Cols to internal 0-based
+    if (column < 1 || column > Cols) {
+        return false;
+    }
+    if (!playMoveInternal(column - 1, player)) {
+        return false;
+    }
+#if CONNECT4_THREADS
+    updatePondering(column - 1, player);
+#endif
+    return true;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4<Rows, Cols, Win>::calculateBestMove(Player player, uint8_t depth) {
+    // Calculate best move and convert from internal 0-based to user-facing 1-Cols
+    if (player == Player::NONE) {
+        return 0;  // Return 0 for error (no valid move)
+    }
+    
+#if CONNECT4_THREADS
+    if (depth == 0) depth = 1;  // Same minimum as the AI; 0 marks timed searches
+    int8_t bestMove = takePonderMove(player, depth, 0);
+    if (bestMove < 0) bestMove = ai.calculateBestMove(board, player, depth);
+    recordAIMove(bestMove, player, depth);
+#else
+    int8_t bestMove = ai.calculateBestMove(board, player, depth);
+#endif
+    
+    if (bestMove < 0) {
+        return 0;  // Return 0 for error (no valid move)
+    }
+    
+    return static_cast<uint8_t>(bestMove + 1);  // Convert to 1-Cols
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4<Rows, Cols, Win>::calculateBestMoveTimed(Player player, uint32_t maxMillis) {
+    if (player == Player::NONE) {
+        return 0;  // Return 0 for error (no valid move)
+    }
+    
+#if CONNECT4_THREADS
+    int8_t bestMove = takePonderMove(player, 0, maxMillis);
+    if (bestMove < 0) bestMove = ai.calculateBestMoveTimed(board, player, maxMillis);
+    recordAIMove(bestMove, player, 0);
+#else
+    int8_t bestMove = ai.calculateBestMoveTimed(board, player, maxMillis);
+#endif
+    
+    if (bestMove < 0) {
+        return 0;  // Return 0 for error (no valid move)
+    }
+    
+    return static_cast<uint8_t>(bestMove + 1);  // Convert to 1-Cols
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4<Rows, Cols, Win>::analyzeMoves(Player player, uint8_t depth, int32_t scores[Cols],
+                                                     uint8_t* lines, uint8_t lineLength) {
+#if CONNECT4_THREADS
+    // The analysis replaces the expected reply of an AI move not played
+    // yet: that move is not pondered on. A running ponder search goes on
+    // beside the analysis, both storing in the table (safe to share, see
+    // Connect4TranspositionTable.h)
+    lastAIMove = -1;
+#endif
+    
+    // Lines are filled 0-based (-1 past the end), then shifted to 1-Cols
+    int8_t* columns = reinterpret_cast<int8_t*>(lines);
+    int8_t bestMove = ai.analyzeMoves(board, player, depth, scores, lines ? columns : nullptr, lineLength);
+    for (uint16_t i = 0; lines && i < static_cast<uint16_t>(Cols) * lineLength; i++) {
+        lines[i] = static_cast<uint8_t>(columns[i] + 1);
+    }
+    
+    return bestMove < 0 ? 0 : static_cast<uint8_t>(bestMove + 1);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAIThreads(uint8_t count) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setThreads(count);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAIAlgorithm(SearchAlgorithm algorithm) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setSearchAlgorithm(algorithm);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAIPerfectPlay(bool enabled) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setPerfectPlay(enabled);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAIEvalWeights(const Connect4EvalWeights& weights) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setEvalWeights(weights);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAIAspirationWindow(int32_t window) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setAspirationWindow(window);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAILateMoveReductions(bool enabled) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setLateMoveReductions(enabled);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setOpeningBook(const Connect4OpeningBook* book) {
+#if CONNECT4_THREADS
+    stopPondering();
+#endif
+    ai.setOpeningBook(book);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::setAIPondering(bool enabled) {
+#if CONNECT4_THREADS
+    ponderEnabled = enabled;
+    if (!enabled) stopPondering();
+#else
+    (void)enabled;
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint32_t BasicConnect4<Rows, Cols, Win>::getPonderHits() const {
+#if CONNECT4_THREADS
+    return ponderHits;
+#else
+    return 0;
+#endif
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4<Rows, Cols, Win>::getExpectedReply() const {
+    int8_t reply = ai.getExpectedReply();
+    return reply < 0 ? 0 : static_cast<uint8_t>(reply + 1);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4<Rows, Cols, Win>::isValidMove(uint8_t column) const {
+    // User-facing method: convert from 1-Cols to internal 0-based
+    if (column < 1 || column > Cols) {
+        return false;
+    }
+    return board.isValidMove(column - 1);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4<Rows, Cols, Win>::hasWinner() const {
+    return board.hasWinner();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+Player BasicConnect4<Rows, Cols, Win>::getWinner() const {
+    return board.getWinner();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4<Rows, Cols, Win>::isDraw() const {
+    return board.isDraw();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4<Rows, Cols, Win>::isGameOver() const {
+    return board.isGameOver();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+GameState BasicConnect4<Rows, Cols, Win>::getGameState() const {
+    return board.getState();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+const typename BasicConnect4<Rows, Cols, Win>::Board& BasicConnect4<Rows, Cols, Win>::getBoard() const {
+    return board;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+Player BasicConnect4<Rows, Cols, Win>::getCell(uint8_t row, uint8_t col) const {
+    return board.getCell(row, col);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+uint8_t BasicConnect4<Rows, Cols, Win>::getColumnHeight(uint8_t col) const {
+    return board.getColumnHeight(col);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+Player BasicConnect4<Rows, Cols, Win>::getOpponent(Player player) const {
+    if (player == Player::FIRST) return Player::SECOND;
+    if (player == Player::SECOND) return Player::FIRST;
+    return Player::NONE;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::printRule() const {
+    CONNECT4_PRINT("  ");
+    for (uint8_t i = 1; i < 2 * Cols; i++) {
+        CONNECT4_PRINT("-");
+    }
+    CONNECT4_PRINTLN("");
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4<Rows, Cols, Win>::printBoard() const {
+    CONNECT4_PRINT("\n ");
+    for (uint8_t col = 1; col <= Cols; col++) {
+        CONNECT4_PRINT(" ");
+        CONNECT4_PRINT(static_cast<int>(col));
+    }
+    CONNECT4_PRINTLN("");
+    printRule();
+    
+    // Print from top to bottom (last row to 0)
+    for (int8_t row = Rows - 1; row >= 0; row--) {
+        CONNECT4_PRINT("|");
+        for (uint8_t col = 0; col < Cols; col++) {
+            Player cell = board.getCell(row, col);
+            if (cell == Player::FIRST) {
+                CONNECT4_PRINT(" X");
+            } else if (cell == Player::SECOND) {
+                CONNECT4_PRINT(" O");
+            } else {
+                CONNECT4_PRINT(" .");
+            }
+        }
+        CONNECT4_PRINTLN(" |");
+    }
+    
+    printRule();
+    CONNECT4_PRINTLN("");
+}
+
+#endif // CONNECT4_IMPL_H
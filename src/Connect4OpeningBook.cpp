@@ -0,0 +1,123 @@
+#include "Connect4OpeningBook.h"
+
+// Books embedded on AVR live in flash and need explicit program-memory reads
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#endif
+
+uint8_t Connect4OpeningBook::readByte(const uint8_t* address) {
+#ifdef __AVR__
+    return pgm_read_byte(address);
+#else
+    return *address;
+#endif
+}
+
+uint64_t Connect4OpeningBook::readRecord(uint32_t index, uint8_t& column) const {
+    // The first byte holds the column and the low 4 bits of the key, so a
+    // 64-bit key is read without shifting bits out
+    const uint8_t* record = records + index * recordSize;
+    uint64_t key = 0;
+    for (uint8_t i = recordSize - (solved ? 2 : 1); i > 0; i--) {
+        key = (key << 8) | readByte(record + i);
+    }
+    uint8_t low = readByte(record);
+    column = low & 0x0F;
+    return (key << 4) | (low >> 4);
+}
+
+bool Connect4OpeningBook::load(const uint8_t* bytes, uint32_t size, uint8_t rows, uint8_t cols, uint8_t win) {
+    records = nullptr;
+    count = 0;
+    maxPly = 0;
+    bookRows = 0;
+    bookCols = 0;
+    bookWin = 0;
+    recordSize = 0;
+    solved = false;
+
+    if (bytes == nullptr || size < HEADER_SIZE) {
+        return false;
+    }
+    uint8_t kind = readByte(bytes + 3);
+    if (readByte(bytes) != 'C' || readByte(bytes + 1) != '4' || readByte(bytes + 2) != 'B' ||
+        (kind != 'K' && kind != 'S') || readByte(bytes + 4) != VERSION) {
+        return false;
+    }
+    if (readByte(bytes + 6) != rows || readByte(bytes + 7) != ((cols << 4) | win)) {
+        return false;
+    }
+
+    solved = kind == 'S';
+    bookRows = rows;
+    bookCols = cols;
+    bookWin = win;
+    recordSize = connect4BookRecordSize(static_cast<uint8_t>((rows + 1) * cols), solved);
+    records = bytes + HEADER_SIZE;
+    count = (size - HEADER_SIZE) / recordSize;
+    maxPly = readByte(bytes + 5);
+    return true;
+}
+
+bool Connect4OpeningBook::find(uint64_t key, uint32_t& index, uint8_t& column) const {
+    uint32_t low = 0;
+    uint32_t high = count;
+
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        uint64_t recordKey = readRecord(mid, column);
+
+        if (recordKey == key) {
+            index = mid;
+            return true;
+        }
+        if (recordKey < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
+int8_t Connect4OpeningBook::lookup(uint64_t key) const {
+    uint32_t index;
+    uint8_t column;
+    return find(key, index, column) ? static_cast<int8_t>(column) : -1;
+}
+
+bool Connect4OpeningBook::lookupScore(uint64_t key, int8_t& score) const {
+    uint32_t index;
+    uint8_t column;
+    if (!solved || !find(key, index, column)) return false;
+    score = static_cast<int8_t>(readByte(records + (index + 1) * recordSize - 1));
+    return true;
+}
+
+void Connect4OpeningBook::writeHeader(uint8_t out[HEADER_SIZE], uint8_t maxPly, uint8_t rows,
+                                      uint8_t cols, uint8_t win, bool solved) {
+    out[0] = 'C';
+    out[1] = '4';
+    out[2] = 'B';
+    out[3] = solved ? 'S' : 'K';
+    out[4] = VERSION;
+    out[5] = maxPly;
+    out[6] = rows;
+    out[7] = static_cast<uint8_t>((cols << 4) | win);
+}
+
+void Connect4OpeningBook::writeRecord(uint8_t* out, uint64_t key, uint8_t column, uint8_t size) {
+    out[0] = static_cast<uint8_t>((key << 4) | (column & 0x0F));
+    uint64_t rest = key >> 4;
+    for (uint8_t i = 1; i < size; i++) {
+        out[i] = static_cast<uint8_t>(rest);
+        rest >>= 8;
+    }
+}
+
+void Connect4OpeningBook::writeSolvedRecord(uint8_t* out, uint64_t key, uint8_t column, int8_t score,
+                                            uint8_t size) {
+    writeRecord(out, key, column, size - 1);
+    out[size - 1] = static_cast<uint8_t>(score);
+}
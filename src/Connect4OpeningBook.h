@@ -0,0 +1,119 @@
+#ifndef CONNECT4_OPENING_BOOK_H
+#define CONNECT4_OPENING_BOOK_H
+
+#include "Connect4BitBoard.h"
+#include <stdint.h>
+
+// Bytes of a book record for keys of keyBits bits: the key and a 4-bit
+// column, then the score in solved books
+constexpr uint8_t connect4BookRecordSize(uint8_t keyBits, bool solved = false) {
+    return ((keyBits < 64 ? keyBits : 64) + 4 + 7) / 8 + (solved ? 1 : 0);
+}
+
+// Read-only opening book: best moves of precomputed positions.
+//
+// Binary format (little-endian, generated by tools/connect4_book.cpp):
+//   header  8 bytes: 'C' '4' 'B', 'K' (searched) or 'S' (solved), version,
+//           max ply, rows, (columns << 4) | alignment length
+//   records (canonical key << 4) | column, sorted by key, in as many bytes
+//           as the geometry's keys need (7 on the standard board, 9 for
+//           64-bit and hashed keys); solved books add the exact score
+//           (see Connect4AI::solve) for the side to move as a signed byte
+//
+// The solver takes the scores of a solved book instead of searching the
+// positions it holds: a book of every position up to some ply cuts all of
+// its searches there.
+//
+// Keys are canonical (see Connect4BitBoard::getCanonicalKey): a position and
+// its mirror image share one record, whose column is for the position with
+// the smaller key. A book only answers boards of the geometry in its header.
+//
+// The same bytes can be embedded as a PROGMEM array on microcontrollers
+// (the generator emits a header file for that) or loaded from a file on
+// servers. Lookups are a binary search, no copy of the data is made.
+class Connect4OpeningBook {
+public:
+    static constexpr uint8_t HEADER_SIZE = 8;
+    static constexpr uint8_t RECORD_SIZE = connect4BookRecordSize((BOARD_ROWS + 1) * BOARD_COLS);
+    static constexpr uint8_t SOLVED_RECORD_SIZE = connect4BookRecordSize((BOARD_ROWS + 1) * BOARD_COLS, true);
+    static constexpr uint8_t MAX_RECORD_SIZE = connect4BookRecordSize(64, true);
+    static constexpr uint8_t VERSION = 3;
+
+    Connect4OpeningBook()
+        : records(nullptr), count(0), maxPly(0), bookRows(0), bookCols(0), bookWin(0), recordSize(0), solved(false) {}
+
+    // Use the book stored in bytes (must outlive the book; on AVR it must
+    // be in PROGMEM). Returns false if the header is invalid or the book was
+    // generated for another geometry.
+    bool load(const uint8_t* bytes, uint32_t size, uint8_t rows = BOARD_ROWS,
+              uint8_t cols = BOARD_COLS, uint8_t win = CONNECT_WIN);
+
+    // Best column (0-6) for the side to move, or -1 if not in the book.
+    // Books hold keys of the board geometry they were generated for.
+    template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+    int8_t lookup(const BasicConnect4BitBoard<Rows, Cols, Win>& board) const {
+        if (!holds(board)) return -1;
+        int8_t move = lookup(board.getCanonicalKey());
+        return (move >= 0 && board.isMirrored()) ? BasicConnect4BitBoard<Rows, Cols, Win>::mirrorColumn(move) : move;
+    }
+
+    // Column stored for a canonical key, or -1
+    int8_t lookup(uint64_t key) const;
+
+    // Exact score of the position for the side to move, if the book is
+    // solved and holds it
+    template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+    bool lookupScore(const BasicConnect4BitBoard<Rows, Cols, Win>& board, int8_t& score) const {
+        if (!solved || !holds(board)) return false;
+        return lookupScore(board.getCanonicalKey(), score);
+    }
+
+    bool lookupScore(uint64_t key, int8_t& score) const;
+
+    bool isSolved() const {
+        return solved;
+    }
+
+    uint32_t getCount() const {
+        return count;
+    }
+
+    uint8_t getMaxPly() const {
+        return maxPly;
+    }
+
+    // Serialization helpers for book generators (size: see
+    // connect4BookRecordSize)
+    static void writeHeader(uint8_t out[HEADER_SIZE], uint8_t maxPly, uint8_t rows = BOARD_ROWS,
+                            uint8_t cols = BOARD_COLS, uint8_t win = CONNECT_WIN, bool solved = false);
+    static void writeRecord(uint8_t* out, uint64_t key, uint8_t column, uint8_t size = RECORD_SIZE);
+    static void writeSolvedRecord(uint8_t* out, uint64_t key, uint8_t column, int8_t score,
+                                  uint8_t size = SOLVED_RECORD_SIZE);
+
+private:
+    const uint8_t* records;
+    uint32_t count;
+    uint8_t maxPly;
+    uint8_t bookRows;     // Geometry in the header
+    uint8_t bookCols;
+    uint8_t bookWin;
+    uint8_t recordSize;
+    bool solved;
+
+    // True if board is of the book's geometry and within its plies (keys
+    // of other geometries may have the same width)
+    template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+    bool holds(const BasicConnect4BitBoard<Rows, Cols, Win>& board) const {
+        return Rows == bookRows && Cols == bookCols && Win == bookWin && board.getMoveCount() <= maxPly;
+    }
+
+    static uint8_t readByte(const uint8_t* address);
+
+    // Key of a record, and its column in column
+    uint64_t readRecord(uint32_t index, uint8_t& column) const;
+
+    // Binary search: index of the record of key, and its column
+    bool find(uint64_t key, uint32_t& index, uint8_t& column) const;
+};
+
+#endif // CONNECT4_OPENING_BOOK_H
@@ -0,0 +1,3 @@
+#include "Connect4Search.h"
+
+template class BasicConnect4Search<>;
@@ -0,0 +1,151 @@
+#ifndef CONNECT4_SEARCH_H
+#define CONNECT4_SEARCH_H
+
+#include "Connect4AI.h"
+#include <stdint.h>
+
+// Resumable search: the alpha-beta search of Connect4AI run in slices of a
+// given number of nodes, for cooperative loops (Arduino loop(), a server
+// multiplexing many searches on one thread).
+//
+// The tree is walked with an explicit stack of fixed size instead of
+// recursion, so the search state lives in this object (about 2 KB on the
+// standard board, less with a lower CONNECT4_MAX_PLY) and the call stack
+// stays flat. Iterative deepening: result() is the best move of the deepest
+// completed iteration and can be used as soon as depth 1 is done.
+//
+//   search.start(board, Player::SECOND, 10);
+//   while (!search.step(500)) {
+//       updateDisplay();
+//   }
+//   int8_t column = search.result();
+//
+// Table entries are the same as Connect4AI's (the shared table by default).
+template <uint8_t Rows = BOARD_ROWS, uint8_t Cols = BOARD_COLS, uint8_t Win = CONNECT_WIN>
+class BasicConnect4Search {
+public:
+    typedef BasicConnect4Board<Rows, Cols, Win> Board;
+    typedef BasicConnect4BitBoard<Rows, Cols, Win> BitBoard;
+    typedef typename BitBoard::Bits Bits;
+    typedef BasicConnect4Evaluator<Rows, Cols, Win> Evaluator;
+
+    BasicConnect4Search();
+
+    // Start searching a copy of board for player, up to maxDepth plies
+    // (at most Connect4AI::MAX_PLY). A game that is over is done at once,
+    // with no move.
+    void start(const Board& board, Player player, uint8_t maxDepth = Rows * Cols);
+    void start(const BitBoard& board, Player player, uint8_t maxDepth = Rows * Cols);
+
+    // Search about nodeBudget more nodes; true once the search is done
+    // (maxDepth completed or a forced result found)
+    bool step(uint32_t nodeBudget);
+
+    bool isDone() const {
+        return done;
+    }
+
+    // Best column (0-based) of the deepest completed iteration, -1 if none yet
+    int8_t result() const {
+        return bestMove;
+    }
+
+    // Score of result() for player (see Connect4AI::getLastScore)
+    int32_t getScore() const {
+        return bestScore;
+    }
+
+    // Depth of the deepest completed iteration
+    uint8_t getDepth() const {
+        return completedDepth;
+    }
+
+    uint64_t getNodeCount() const {
+        return nodeCount;
+    }
+
+    // Use another transposition table, or nullptr to search without one
+    void setTranspositionTable(Connect4TranspositionTable* newTable) {
+        table = newTable;
+    }
+
+    Connect4TranspositionTable* getTranspositionTable() const {
+        return table;
+    }
+
+    // Weights of the heuristic evaluation, used from the next start() (see
+    // Connect4AI::setEvalWeights)
+    void setEvalWeights(const Connect4EvalWeights& weights) {
+        evaluator.setWeights(weights);
+        weightsKey = AI::keyOfWeights(weights);
+    }
+
+private:
+    typedef BasicConnect4AI<Rows, Cols, Win> AI;
+
+    static constexpr int32_t WIN_SCORE = Evaluator::WIN_SCORE;
+
+    // One node of the current line: what a recursive search keeps in locals
+    struct Frame {
+        uint64_t key;
+        Bits moves;           // Moves allowed at this node
+        int32_t alpha;
+        int32_t beta;
+        int32_t alphaOrig;
+        int32_t betaOrig;
+        int32_t bestEval;
+        uint8_t depth;        // Remaining depth
+        uint8_t next;         // Next index in order
+        int8_t bestMove;
+        int8_t played;        // Column of the child being searched, or -1
+        bool maximizing;      // aiPlayer to move
+        uint8_t order[Cols];
+    };
+
+    BitBoard board;
+    Evaluator evaluator;
+    Connect4TranspositionTable* table;
+    uint64_t weightsKey;      // See Connect4AI::keyOfWeights
+
+    Frame stack[AI::MAX_PLY + 1];
+    uint8_t top;              // Frames in use; 0 between iterations
+    int32_t childValue;       // Value returned by the last finished child...
+    bool hasChildValue;       // ...not yet taken by its parent
+
+    Player aiPlayer;
+    uint8_t maxDepth;
+    uint8_t depth;            // Depth of the current iteration
+    uint8_t completedDepth;
+    int8_t bestMove;
+    int32_t bestScore;
+    uint64_t nodeCount;
+    Bits rootMoves;           // Moves searched at the root
+    bool done;
+
+    Player playerOf(const Frame& frame) const {
+        return frame.maximizing ? aiPlayer
+                                : (aiPlayer == Player::FIRST ? Player::SECOND : Player::FIRST);
+    }
+
+    void play(uint8_t col, Player player);
+    void unplay(uint8_t col);
+
+    // Push the root of the next iteration
+    void beginIteration();
+
+    // Visit the position just played: either its value is known at once
+    // (childValue) or a frame is pushed to search its moves
+    void enter(uint8_t remaining, int32_t alpha, int32_t beta, bool maximizing);
+
+    // Store the finished top frame in the table and return its value to
+    // the parent, or end the iteration at the root
+    void leave();
+};
+
+#include "Connect4SearchImpl.h"
+
+// The standard board is compiled once, in Connect4Search.cpp
+extern template class BasicConnect4Search<>;
+typedef BasicConnect4Search<> Connect4Search;
+
+#endif // CONNECT4_SEARCH_H
@@ -0,0 +1,228 @@
+#ifndef CONNECT4_SEARCH_IMPL_H
+#define CONNECT4_SEARCH_IMPL_H
+
+// Member definitions of BasicConnect4Search, included by Connect4Search.h
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+BasicConnect4Search<Rows, Cols, Win>::BasicConnect4Search()
+    : table(&Connect4TranspositionTable::shared()), weightsKey(0), top(0), childValue(0), hasChildValue(false),
+      aiPlayer(Player::FIRST), maxDepth(1), depth(1), completedDepth(0), bestMove(-1), bestScore(0),
+      nodeCount(0), rootMoves(0), done(true) {}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::play(uint8_t col, Player player) {
+    uint8_t row = board.getColumnHeight(col);
+    board.makeMove(col, player);
+    evaluator.addStone(row, col, player);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::unplay(uint8_t col) {
+    uint8_t row = board.getColumnHeight(col) - 1;
+    evaluator.removeStone(row, col, board.getCell(row, col));
+    board.undoMove(col);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::start(const Board& position, Player player, uint8_t depthLimit) {
+    start(BitBoard(position), player, depthLimit);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::start(const BitBoard& position, Player player, uint8_t depthLimit) {
+    board = position;
+    evaluator.load(board);
+    aiPlayer = player;
+    maxDepth = depthLimit == 0 ? 1 : (depthLimit > AI::MAX_PLY ? AI::MAX_PLY : depthLimit);
+    depth = 1;
+    completedDepth = 0;
+    bestMove = -1;
+    bestScore = 0;
+    nodeCount = 0;
+    top = 0;
+    hasChildValue = false;
+    done = board.isGameOver();
+    if (done) return;
+
+    if (table) table->newSearch();
+
+    // Same root moves as Connect4AI: an immediate win ends the search,
+    // moves that lose at once are skipped unless all do
+    const uint8_t* centerOrder = Connect4CenterOrder<Cols>::columns;
+    if (board.canWinNext(player)) {
+        Bits wins = board.getWinningCells(player) & board.getPlayableCells();
+        for (uint8_t i = 0; i < Cols && bestMove < 0; i++) {
+            if (wins & BitBoard::columnMask(centerOrder[i])) bestMove = centerOrder[i];
+        }
+        bestScore = WIN_SCORE + 1;
+        completedDepth = 1;
+        done = true;
+        return;
+    }
+    rootMoves = board.getNonLosingCells(player);
+    if (rootMoves == 0) rootMoves = board.getPlayableCells();
+    if (board.isSymmetric()) rootMoves &= BitBoard::leftHalfMask();
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::beginIteration() {
+    Frame& root = stack[0];
+    root.key = 0;
+    root.moves = rootMoves;
+    root.alpha = -INT32_MAX;
+    root.beta = INT32_MAX;
+    root.alphaOrig = root.alpha;
+    root.betaOrig = root.beta;
+    root.bestEval = -INT32_MAX;
+    root.depth = depth;
+    root.next = 0;
+    root.bestMove = -1;
+    root.played = -1;
+    root.maximizing = true;
+    // Best move of the previous iteration first
+    AI::orderMoves(bestMove, root.order);
+    top = 1;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::enter(uint8_t remaining, int32_t alpha, int32_t beta, bool maximizing) {
+    // Terminal tests and table probe of Connect4AI::negamax, with the value
+    // handed back through childValue instead of returned
+    nodeCount++;
+    hasChildValue = true;
+    int32_t sign = maximizing ? 1 : -1;
+
+    if (board.hasWinner()) {
+        childValue = -WIN_SCORE - remaining;
+        return;
+    }
+    if (board.isDraw() || remaining == 0) {
+        childValue = sign * evaluator.getScore(aiPlayer);
+        return;
+    }
+
+    Player current = maximizing ? aiPlayer : (aiPlayer == Player::FIRST ? Player::SECOND : Player::FIRST);
+    if (board.canWinNext(current)) {
+        childValue = WIN_SCORE + remaining - 1;
+        return;
+    }
+    Bits moves = board.getNonLosingCells(current);
+    if (moves == 0) {
+        childValue = -WIN_SCORE - (remaining >= 2 ? remaining - 2 : 0);
+        return;
+    }
+
+    uint64_t key = AI::tableKey(board, maximizing, aiPlayer, weightsKey);
+    int32_t alphaOrig = alpha;
+    int32_t betaOrig = beta;
+    int8_t ttMove = -1;
+    Connect4TTEntry entry;
+    if (table && table->probe(key, entry)) {
+        ttMove = AI::tableMove(board, entry.bestMove);
+        if (entry.depth >= remaining) {
+            int32_t score = sign * entry.score;
+            TTBound bound = entry.bound;
+            if (!maximizing && bound == TTBound::LOWER) bound = TTBound::UPPER;
+            else if (!maximizing && bound == TTBound::UPPER) bound = TTBound::LOWER;
+
+            if (bound == TTBound::EXACT) {
+                childValue = score;
+                return;
+            }
+            if (bound == TTBound::LOWER && score > alpha) alpha = score;
+            if (bound == TTBound::UPPER && score < beta) beta = score;
+            if (beta <= alpha) {
+                childValue = score;
+                return;
+            }
+        }
+    }
+
+    hasChildValue = false;
+    Frame& frame = stack[top++];
+    frame.key = key;
+    frame.moves = moves;
+    frame.alpha = alpha;
+    frame.beta = beta;
+    frame.alphaOrig = alphaOrig;
+    frame.betaOrig = betaOrig;
+    frame.bestEval = -INT32_MAX;
+    frame.depth = remaining;
+    frame.next = 0;
+    frame.bestMove = -1;
+    frame.played = -1;
+    frame.maximizing = maximizing;
+    AI::orderMoves(ttMove, frame.order);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+void BasicConnect4Search<Rows, Cols, Win>::leave() {
+    const Frame& frame = stack[--top];
+
+    if (top == 0) {
+        // Root done: the iteration is complete
+        bestMove = frame.bestMove;
+        bestScore = frame.bestEval;
+        completedDepth = depth;
+        if (bestScore >= WIN_SCORE || bestScore <= -WIN_SCORE || depth >= maxDepth) {
+            done = true;
+        } else {
+            depth++;
+        }
+        return;
+    }
+
+    if (table) {
+        int32_t sign = frame.maximizing ? 1 : -1;
+        TTBound bound = TTBound::EXACT;
+        if (frame.bestEval <= frame.alphaOrig) bound = frame.maximizing ? TTBound::UPPER : TTBound::LOWER;
+        else if (frame.bestEval >= frame.betaOrig) bound = frame.maximizing ? TTBound::LOWER : TTBound::UPPER;
+        table->store(frame.key, frame.depth, bound, sign * frame.bestEval, AI::tableMove(board, frame.bestMove));
+    }
+    childValue = frame.bestEval;
+    hasChildValue = true;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Win>
+bool BasicConnect4Search<Rows, Cols, Win>::step(uint32_t nodeBudget) {
+    while (!done && nodeBudget > 0) {
+        if (top == 0) {
+            beginIteration();
+            continue;
+        }
+        Frame& frame = stack[top - 1];
+
+        // Take the value of the child just searched
+        if (hasChildValue) {
+            hasChildValue = false;
+            int32_t eval = -childValue;
+            unplay(static_cast<uint8_t>(frame.played));
+            if (eval > frame.bestEval || frame.bestMove < 0) {
+                frame.bestEval = eval;
+                frame.bestMove = frame.played;
+            }
+            if (eval > frame.alpha) frame.alpha = eval;
+            if (frame.alpha >= frame.beta) {
+                leave();
+                continue;
+            }
+        }
+
+        // Then search the next move, or finish the node
+        while (frame.next < Cols && !(frame.moves & BitBoard::columnMask(frame.order[frame.next]))) {
+            frame.next++;
+        }
+        if (frame.next == Cols) {
+            leave();
+            continue;
+        }
+        uint8_t col = frame.order[frame.next++];
+        frame.played = static_cast<int8_t>(col);
+        play(col, playerOf(frame));
+        nodeBudget--;
+        enter(frame.depth - 1, -frame.beta, -frame.alpha, !frame.maximizing);
+    }
+    return done;
+}
+
+#endif // CONNECT4_SEARCH_IMPL_H
@@ -0,0 +1,89 @@
+#ifndef CONNECT4_SEARCH_STATS_H
+#define CONNECT4_SEARCH_STATS_H
+
+#include "Connect4Board.h"
+#include <stdint.h>
+
+// Collect search statistics (see Connect4AI::getSearchStats).
+// Disabled by default on Arduino; when disabled the counters are compiled
+// out of the search, Connect4AI carries no SearchStats and
+// getSearchStats() returns a shared instance where every field is zero.
+#ifndef CONNECT4_SEARCH_STATS
+#ifdef ARDUINO
+#define CONNECT4_SEARCH_STATS 0
+#else
+#define CONNECT4_SEARCH_STATS 1
+#endif
+#endif
+
+#if CONNECT4_SEARCH_STATS
+#define CONNECT4_STAT(statement) statement
+#else
+#define CONNECT4_STAT(statement)
+#endif
+
+struct SearchStats {
+    static constexpr uint8_t MAX_ITERATIONS = CONNECT4_SEARCH_STATS ? BOARD_ROWS * BOARD_COLS : 1;
+
+    uint64_t nodes;             // Positions visited
+    uint64_t leafEvaluations;   // Heuristic evaluations at the horizon
+    uint64_t betaCutoffs;       // Nodes cut by alpha-beta
+    uint64_t firstMoveCutoffs;  // ... of which by the first move searched
+    uint64_t tableProbes;       // Transposition table lookups
+    uint64_t tableHits;         // ... that found the position
+    uint64_t reducedMoves;      // Late moves searched a ply shallower first
+    uint64_t reductionResearches;  // ... searched again at full depth
+    uint32_t aspirationResearches; // Root searches repeated outside the window
+    uint8_t maxDepth;           // Deepest ply reached below the root
+    uint32_t stackBytes;        // Deepest stack use below the search call
+    uint8_t iterations;         // Completed iterative deepening iterations
+    uint32_t iterationMillis[MAX_ITERATIONS];  // Time of each iteration
+
+    SearchStats() {
+        reset();
+    }
+
+    void reset() {
+        nodes = 0;
+        leafEvaluations = 0;
+        betaCutoffs = 0;
+        firstMoveCutoffs = 0;
+        tableProbes = 0;
+        tableHits = 0;
+        reducedMoves = 0;
+        reductionResearches = 0;
+        aspirationResearches = 0;
+        maxDepth = 0;
+        stackBytes = 0;
+        iterations = 0;
+        for (uint8_t i = 0; i < MAX_ITERATIONS; i++) {
+            iterationMillis[i] = 0;
+        }
+    }
+
+    // Add the counters of another search (e.g. a helper thread)
+    void merge(const SearchStats& other) {
+        nodes += other.nodes;
+        leafEvaluations += other.leafEvaluations;
+        betaCutoffs += other.betaCutoffs;
+        firstMoveCutoffs += other.firstMoveCutoffs;
+        tableProbes += other.tableProbes;
+        tableHits += other.tableHits;
+        reducedMoves += other.reducedMoves;
+        reductionResearches += other.reductionResearches;
+        aspirationResearches += other.aspirationResearches;
+        if (other.maxDepth > maxDepth) maxDepth = other.maxDepth;
+        if (other.stackBytes > stackBytes) stackBytes = other.stackBytes;
+    }
+
+    // Fraction of cutoffs produced by the first move (move ordering quality)
+    float firstMoveCutoffRate() const {
+        return betaCutoffs ? static_cast<float>(firstMoveCutoffs) / betaCutoffs : 0.0f;
+    }
+
+    float tableHitRate() const {
+        return tableProbes ? static_cast<float>(tableHits) / tableProbes : 0.0f;
+    }
+};
+
+#endif // CONNECT4_SEARCH_STATS_H
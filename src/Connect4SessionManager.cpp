@@ -0,0 +1,207 @@
+#include "Connect4SessionManager.h"
+
+#if CONNECT4_THREADS
+
+#include <algorithm>
+
+Connect4SessionManager::Worker::Worker(uint8_t tableSizeBits)
+    : storage(static_cast<size_t>(1) << tableSizeBits), table(&storage[0], tableSizeBits) {
+    ai.setTranspositionTable(&table);
+}
+
+Connect4SessionManager::Connect4SessionManager(uint32_t capacity, uint8_t threadCount, uint8_t tableSizeBits)
+    : sessions(capacity), batchNumber(0), busy(0), stopping(false), next(0) {
+    if (threadCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        threadCount = static_cast<uint8_t>(hardware == 0 ? 1 : (hardware > 255 ? 255 : hardware));
+    }
+    for (uint8_t i = 0; i < threadCount; i++) {
+        workers.push_back(std::unique_ptr<Worker>(new Worker(tableSizeBits)));
+    }
+
+    // Lowest slots first: live sessions stay packed at the front of the pool
+    freeSlots.reserve(capacity);
+    for (uint32_t slot = capacity; slot > 0; slot--) {
+        freeSlots.push_back(slot - 1);
+    }
+    for (uint32_t slot = 0; slot < capacity; slot++) {
+        sessions[slot].generation = 1;
+        sessions[slot].active = false;
+        sessions[slot].pending = false;
+    }
+    requests.reserve(capacity);
+    batch.reserve(capacity);
+
+    for (size_t i = 1; i < workers.size(); i++) {
+        threads.push_back(std::thread(&Connect4SessionManager::workerLoop, this, workers[i].get()));
+    }
+}
+
+Connect4SessionManager::~Connect4SessionManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+Connect4SessionManager::Session* Connect4SessionManager::find(Connect4SessionHandle handle) {
+    uint32_t slot = static_cast<uint32_t>(handle);
+    if (slot >= sessions.size()) return nullptr;
+    Session& session = sessions[slot];
+    if (!session.active || session.generation != static_cast<uint32_t>(handle >> 32)) return nullptr;
+    return &session;
+}
+
+const Connect4SessionManager::Session* Connect4SessionManager::find(Connect4SessionHandle handle) const {
+    return const_cast<Connect4SessionManager*>(this)->find(handle);
+}
+
+Connect4SessionHandle Connect4SessionManager::create() {
+    if (freeSlots.empty()) return INVALID_HANDLE;
+
+    uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    Session& session = sessions[slot];
+    session.board.reset();
+    session.active = true;
+    session.pending = false;
+    session.lastAIMove = -1;
+    session.lastAIScore = 0;
+    return (static_cast<uint64_t>(session.generation) << 32) | slot;
+}
+
+bool Connect4SessionManager::destroy(Connect4SessionHandle handle) {
+    Session* session = find(handle);
+    if (!session) return false;
+
+    session->active = false;
+    session->pending = false;
+    // Generation 0 is skipped so that no handle equals INVALID_HANDLE
+    if (++session->generation == 0) session->generation = 1;
+    freeSlots.push_back(static_cast<uint32_t>(handle));
+    return true;
+}
+
+bool Connect4SessionManager::reset(Connect4SessionHandle handle) {
+    Session* session = find(handle);
+    if (!session) return false;
+
+    session->board.reset();
+    session->pending = false;
+    session->lastAIMove = -1;
+    session->lastAIScore = 0;
+    return true;
+}
+
+bool Connect4SessionManager::isValid(Connect4SessionHandle handle) const {
+    return find(handle) != nullptr;
+}
+
+bool Connect4SessionManager::playMove(Connect4SessionHandle handle, uint8_t column, Player player) {
+    Session* session = find(handle);
+    if (!session || session->pending || column < 1 || column > BOARD_COLS || player == Player::NONE) return false;
+    return session->board.makeMove(column - 1, player);
+}
+
+const Connect4BitBoard* Connect4SessionManager::getBoard(Connect4SessionHandle handle) const {
+    const Session* session = find(handle);
+    return session ? &session->board : nullptr;
+}
+
+bool Connect4SessionManager::requestMove(Connect4SessionHandle handle, Player player, uint8_t depth) {
+    Session* session = find(handle);
+    if (!session || session->pending || session->board.isGameOver() || player == Player::NONE) {
+        return false;
+    }
+
+    session->pending = true;
+    session->requestPlayer = player;
+    session->requestDepth = depth;
+    requests.push_back(static_cast<uint32_t>(handle));
+    return true;
+}
+
+void Connect4SessionManager::runRequest(Worker& worker, Session& session) {
+    session.lastAIMove = worker.ai.calculateBestMove(session.board, session.requestPlayer, session.requestDepth);
+    session.lastAIScore = worker.ai.getLastScore();
+    if (session.lastAIMove >= 0) {
+        session.board.makeMove(static_cast<uint8_t>(session.lastAIMove), session.requestPlayer);
+    }
+}
+
+size_t Connect4SessionManager::processRequests() {
+    // Requests of reset or destroyed games were cancelled, and a slot can be
+    // queued twice if it was cancelled and requested again: keep one
+    // request per pending slot, in pool order for the workers
+    batch.clear();
+    for (size_t i = 0; i < requests.size(); i++) {
+        Session& session = sessions[requests[i]];
+        if (session.pending) {
+            session.pending = false;
+            batch.push_back(requests[i]);
+        }
+    }
+    requests.clear();
+    std::sort(batch.begin(), batch.end());
+
+    if (batch.empty()) return 0;
+
+    // A single request is searched on the calling thread alone
+    next.store(0);
+    if (batch.size() == 1 || threads.empty()) {
+        takeRequests(*workers[0]);
+        return batch.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batchNumber++;
+        busy = threads.size();
+    }
+    wake.notify_all();
+    takeRequests(*workers[0]);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return busy == 0; });
+    return batch.size();
+}
+
+void Connect4SessionManager::takeRequests(Worker& worker) {
+    // Requests are taken one at a time: search times vary a lot between an
+    // opening and an endgame
+    for (size_t i; (i = next.fetch_add(1)) < batch.size(); ) {
+        runRequest(worker, sessions[batch[i]]);
+    }
+}
+
+void Connect4SessionManager::workerLoop(Worker* worker) {
+    uint64_t done = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, done]() { return stopping || batchNumber != done; });
+            if (stopping) return;
+            done = batchNumber;
+        }
+        takeRequests(*worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) finished.notify_one();
+    }
+}
+
+uint8_t Connect4SessionManager::getLastAIMove(Connect4SessionHandle handle) const {
+    const Session* session = find(handle);
+    return (session && session->lastAIMove >= 0) ? static_cast<uint8_t>(session->lastAIMove + 1) : 0;
+}
+
+int32_t Connect4SessionManager::getLastAIScore(Connect4SessionHandle handle) const {
+    const Session* session = find(handle);
+    return session ? session->lastAIScore : 0;
+}
+
+#endif // CONNECT4_THREADS
@@ -0,0 +1,141 @@
+#ifndef CONNECT4_SESSION_MANAGER_H
+#define CONNECT4_SESSION_MANAGER_H
+
+#include "Connect4AI.h"
+#include <stdint.h>
+
+// Hosting many games is for servers: it needs threads and heap-allocated pools
+#if CONNECT4_THREADS
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+// Session id: pool index in the low 32 bits, generation of the slot above
+// (a handle to a destroyed session stays invalid when its slot is reused)
+typedef uint64_t Connect4SessionHandle;
+
+// Hosts many concurrent games on one pool of bitboards.
+//
+// Sessions live in a fixed array allocated once, so a game costs a bitboard
+// and a few flags instead of a Connect4 object with its own AI. AI moves are
+// requested per session and computed in batches by processRequests(), e.g.
+// once per server tick: the batch is sorted by pool index and shared out
+// between a few workers, each owning one Connect4AI and its table for all
+// sessions. The worker threads are started with the manager and wait for
+// batches; the calling thread works on each batch with them. Columns are
+// numbered from 1 to 7, as in Connect4.
+//
+// Not thread-safe: call it from one thread (processRequests() returns once
+// the batch is done).
+class Connect4SessionManager {
+public:
+    static constexpr Connect4SessionHandle INVALID_HANDLE = 0;
+
+    // threads = 0 uses every hardware thread
+    Connect4SessionManager(uint32_t capacity, uint8_t threads = 0, uint8_t tableSizeBits = 18);
+
+    // Stops the worker threads
+    ~Connect4SessionManager();
+
+    // New game on an empty board; INVALID_HANDLE if the pool is full
+    Connect4SessionHandle create();
+
+    // End a game and free its slot
+    bool destroy(Connect4SessionHandle handle);
+
+    // Empty the board of a game (cancels its pending request)
+    bool reset(Connect4SessionHandle handle);
+
+    bool isValid(Connect4SessionHandle handle) const;
+
+    // Play column 1-7; false on an invalid handle or move, or while an AI
+    // move is pending for the session
+    bool playMove(Connect4SessionHandle handle, uint8_t column, Player player);
+
+    // Board of a game, nullptr for an invalid handle
+    const Connect4BitBoard* getBoard(Connect4SessionHandle handle) const;
+
+    // Queue an AI move for player, played by the next processRequests().
+    // False on an invalid handle, a finished game or a request already pending.
+    bool requestMove(Connect4SessionHandle handle, Player player, uint8_t depth);
+
+    // Compute and play every queued AI move; returns the number played
+    size_t processRequests();
+
+    // Column 1-7 of the last AI move played in the game, 0 if none
+    uint8_t getLastAIMove(Connect4SessionHandle handle) const;
+
+    // Score of that move (see Connect4AI::getLastScore)
+    int32_t getLastAIScore(Connect4SessionHandle handle) const;
+
+    uint32_t getSessionCount() const {
+        return static_cast<uint32_t>(sessions.size() - freeSlots.size());
+    }
+
+    uint32_t getCapacity() const {
+        return static_cast<uint32_t>(sessions.size());
+    }
+
+    uint8_t getThreads() const {
+        return static_cast<uint8_t>(workers.size());
+    }
+
+private:
+    struct Session {
+        Connect4BitBoard board;
+        int32_t lastAIScore;
+        uint32_t generation;   // Bumped when the slot is freed
+        bool active;
+        bool pending;          // An AI request is queued...
+        Player requestPlayer;  // ...for this player and depth
+        uint8_t requestDepth;
+        int8_t lastAIMove;     // Column 0-6, or -1
+    };
+
+    // Search engine of one worker thread, shared by all sessions
+    struct Worker {
+        std::vector<Connect4TTSlot> storage;
+        Connect4TranspositionTable table;
+        Connect4AI ai;
+
+        explicit Worker(uint8_t tableSizeBits);
+    };
+
+    std::vector<Session> sessions;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> requests;   // Slots with a request (may repeat)
+    std::vector<uint32_t> batch;      // Slots searched by processRequests()
+    std::vector<std::unique_ptr<Worker> > workers;
+
+    // Threads of workers 1 and up (worker 0 is the caller's) and the batch
+    // hand-off: a new batchNumber wakes them, busy counts those not done
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    uint64_t batchNumber;
+    size_t busy;
+    bool stopping;
+    std::atomic<size_t> next;   // Next batch index to search
+
+    // Session of a handle, nullptr if the handle is stale or invalid
+    Session* find(Connect4SessionHandle handle);
+    const Session* find(Connect4SessionHandle handle) const;
+
+    void runRequest(Worker& worker, Session& session);
+
+    // Search batch requests with worker until none is left
+    void takeRequests(Worker& worker);
+
+    // Body of a worker thread: takeRequests for every batch until stopped
+    void workerLoop(Worker* worker);
+};
+
+#endif // CONNECT4_THREADS
+
+#endif // CONNECT4_SESSION_MANAGER_H
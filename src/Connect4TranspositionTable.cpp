@@ -0,0 +1,83 @@
+#include "Connect4TranspositionTable.h"
+
+Connect4TranspositionTable::Connect4TranspositionTable(Connect4TTSlot* storage, uint8_t sizeBits)
+    : slots(storage), mask((UINT32_C(1) << sizeBits) - 1), generation(0) {
+    clear();
+}
+
+uint64_t Connect4TranspositionTable::pack(const Connect4TTEntry& entry) {
+    // score | depth << 32 | bound << 40 | bestMove << 48 | generation << 56
+    return static_cast<uint64_t>(static_cast<uint32_t>(entry.score)) |
+           static_cast<uint64_t>(entry.depth) << 32 |
+           static_cast<uint64_t>(entry.bound) << 40 |
+           static_cast<uint64_t>(static_cast<uint8_t>(entry.bestMove)) << 48 |
+           static_cast<uint64_t>(entry.generation) << 56;
+}
+
+void Connect4TranspositionTable::unpack(uint64_t key, uint64_t data, Connect4TTEntry& entry) {
+    entry.key = key;
+    entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.depth = static_cast<uint8_t>(data >> 32);
+    entry.bound = static_cast<TTBound>(static_cast<uint8_t>(data >> 40));
+    entry.bestMove = static_cast<int8_t>(static_cast<uint8_t>(data >> 48));
+    entry.generation = static_cast<uint8_t>(data >> 56);
+}
+
+void Connect4TranspositionTable::clear() {
+    for (uint32_t i = 0; i <= mask; i++) {
+        save(slots[i].check, 0);
+        save(slots[i].data, 0);
+    }
+}
+
+bool Connect4TranspositionTable::probe(uint64_t key, Connect4TTEntry& entry) const {
+    const Connect4TTSlot& slot = slots[indexOf(key)];
+    uint64_t data = load(slot.data);
+    uint64_t check = load(slot.check);
+    if (data == 0 || (check ^ data) != key) {
+        return false;
+    }
+    unpack(key, data, entry);
+    return entry.bound != TTBound::NONE;
+}
+
+void Connect4TranspositionTable::store(uint64_t key, uint8_t depth, TTBound bound, int32_t score, int8_t bestMove) {
+    Connect4TTSlot& slot = slots[indexOf(key)];
+
+    uint64_t oldData = load(slot.data);
+    uint64_t oldKey = load(slot.check) ^ oldData;
+    Connect4TTEntry old;
+    unpack(oldKey, oldData, old);
+
+    uint8_t current = currentGeneration();
+    bool replace = oldData == 0 ||
+                   old.key == key ||
+                   old.generation != current ||
+                   depth >= old.depth;
+    if (!replace) {
+        return;
+    }
+
+    // Keep the known best move when re-storing a position without one
+    if (bestMove < 0 && old.key == key) {
+        bestMove = old.bestMove;
+    }
+
+    Connect4TTEntry entry;
+    entry.key = key;
+    entry.score = score;
+    entry.depth = depth;
+    entry.bound = bound;
+    entry.bestMove = bestMove;
+    entry.generation = current;
+
+    uint64_t data = pack(entry);
+    save(slot.check, key ^ data);
+    save(slot.data, data);
+}
+
+Connect4TranspositionTable& Connect4TranspositionTable::shared() {
+    static Connect4TTSlot storage[UINT32_C(1) << CONNECT4_TT_SIZE_BITS];
+    static Connect4TranspositionTable table(storage, CONNECT4_TT_SIZE_BITS);
+    return table;
+}
@@ -0,0 +1,134 @@
+#ifndef CONNECT4_TRANSPOSITION_TABLE_H
+#define CONNECT4_TRANSPOSITION_TABLE_H
+
+#include <stdint.h>
+
+// Threaded builds share the table between search threads without locks:
+// each slot is two atomic words and the key is stored XORed with the data,
+// so a slot torn by concurrent writers fails verification instead of
+// returning another position's score. The search generation is atomic too:
+// searches of different AIs may start while others store.
+#ifndef CONNECT4_THREADS
+#ifdef ARDUINO
+#define CONNECT4_THREADS 0
+#else
+#define CONNECT4_THREADS 1
+#endif
+#endif
+
+#if CONNECT4_THREADS
+#include <atomic>
+typedef std::atomic<uint64_t> Connect4TTWord;
+typedef std::atomic<uint8_t> Connect4TTGeneration;
+#else
+typedef uint64_t Connect4TTWord;
+typedef uint8_t Connect4TTGeneration;
+#endif
+
+// Size of the shared table as a power of two (entries = 1 << bits).
+// Override at build time, e.g. -DCONNECT4_TT_SIZE_BITS=24 for a 256 MB table.
+#ifndef CONNECT4_TT_SIZE_BITS
+#if defined(__AVR__)
+#define CONNECT4_TT_SIZE_BITS 4     // 256 bytes
+#elif defined(ARDUINO)
+#define CONNECT4_TT_SIZE_BITS 10    // 16 KB
+#else
+#define CONNECT4_TT_SIZE_BITS 20    // 16 MB
+#endif
+#endif
+
+enum class TTBound : uint8_t {
+    NONE,
+    EXACT,
+    LOWER,   // Score is a lower bound (search failed high)
+    UPPER    // Score is an upper bound (search failed low)
+};
+
+// Decoded table entry
+struct Connect4TTEntry {
+    uint64_t key;
+    int32_t score;
+    uint8_t depth;
+    TTBound bound;
+    int8_t bestMove;     // Column 0-6, or -1 if unknown
+    uint8_t generation;  // Search that wrote the entry
+};
+
+// Stored table entry: check = key ^ data, data packs the other fields
+struct Connect4TTSlot {
+    Connect4TTWord check;
+    Connect4TTWord data;
+};
+
+class Connect4TranspositionTable {
+private:
+    Connect4TTSlot* slots;
+    uint32_t mask;
+    Connect4TTGeneration generation;
+
+    uint32_t indexOf(uint64_t key) const {
+        // Fibonacci hashing: spreads the sparse board keys over the table
+        return static_cast<uint32_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & mask;
+    }
+
+    static uint64_t load(const Connect4TTWord& word) {
+#if CONNECT4_THREADS
+        return word.load(std::memory_order_relaxed);
+#else
+        return word;
+#endif
+    }
+
+    static void save(Connect4TTWord& word, uint64_t value) {
+#if CONNECT4_THREADS
+        word.store(value, std::memory_order_relaxed);
+#else
+        word = value;
+#endif
+    }
+
+    uint8_t currentGeneration() const {
+#if CONNECT4_THREADS
+        return generation.load(std::memory_order_relaxed);
+#else
+        return generation;
+#endif
+    }
+
+    static uint64_t pack(const Connect4TTEntry& entry);
+    static void unpack(uint64_t key, uint64_t data, Connect4TTEntry& entry);
+
+public:
+    // Table over caller-provided storage of (1 << sizeBits) slots
+    Connect4TranspositionTable(Connect4TTSlot* storage, uint8_t sizeBits);
+
+    void clear();
+
+    // Start a new search: entries of previous searches become replaceable
+    void newSearch() {
+#if CONNECT4_THREADS
+        generation.fetch_add(1, std::memory_order_relaxed);
+#else
+        generation++;
+#endif
+    }
+
+    // Returns true and fills entry if the key is in the table
+    // Safe to call from several threads while others store
+    bool probe(uint64_t key, Connect4TTEntry& entry) const;
+
+    // Replacement policy: keep the deeper entry of the current search,
+    // always overwrite entries left over from previous searches
+    void store(uint64_t key, uint8_t depth, TTBound bound, int32_t score, int8_t bestMove);
+
+    uint32_t getSize() const {
+        return mask + 1;
+    }
+
+    // Table over static storage sized by CONNECT4_TT_SIZE_BITS, the default
+    // of every AI: AIs on different threads may search it at the same time
+    // in threaded builds, only one at a time with CONNECT4_THREADS=0
+    static Connect4TranspositionTable& shared();
+};
+
+#endif // CONNECT4_TRANSPOSITION_TABLE_H
@@ -1,6 +1,19 @@
 #include "../src/Connect4.h"
+#include "../src/Connect4BitBoard.h"
+#include "../src/Connect4Evaluator.h"
+#include "../src/Connect4OpeningBook.h"
+#include "../src/Connect4GameRecord.h"
+#include "../src/Connect4BatchAnalyzer.h"
+#include "../src/Connect4SessionManager.h"
+#include "../src/Connect4Search.h"
+#include "../src/Connect4Footprint.h"
 #include <iostream>
 #include <chrono>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -230,6 +243,1389 @@ void testTwoPlayers() {
     cout << "✓ Test 7 passed!\n" << endl;
 }
 
+void testBitBoard() {
+    cout << "TEST 8: Bitboard Consistency" << endl;
+    printSeparator();
+    
+    cout << "Replaying pseudo-random games on both board types..." << endl;
+    
+    uint32_t seed = 12345;
+    for (int gameIndex = 0; gameIndex < 200; gameIndex++) {
+        Connect4Board board;
+        Connect4BitBoard bitBoard;
+        Player player = Player::FIRST;
+        
+        while (!board.isGameOver()) {
+            seed = seed * 1103515245 + 12345;
+            uint8_t col = (seed >> 16) % BOARD_COLS;
+            
+            bool played = board.makeMove(col, player);
+            if (played != bitBoard.makeMove(col, player)) {
+                throw runtime_error("Bitboard move validity differs");
+            }
+            if (!played) continue;
+            
+            if (board.getState() != bitBoard.getState() || board.getWinner() != bitBoard.getWinner()) {
+                throw runtime_error("Bitboard game state differs");
+            }
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+        
+        for (uint8_t r = 0; r < BOARD_ROWS; r++) {
+            for (uint8_t c = 0; c < BOARD_COLS; c++) {
+                if (board.getCell(r, c) != bitBoard.getCell(r, c)) {
+                    throw runtime_error("Bitboard cell differs");
+                }
+            }
+        }
+        
+        Connect4BitBoard copy(board);
+        if (copy.getKey() != bitBoard.getKey() || copy.getState() != bitBoard.getState()) {
+            throw runtime_error("Bitboard conversion differs");
+        }
+    }
+    
+    cout << "✓ Bitboard matches array board on 200 games" << endl;
+    cout << "✓ Test 8 passed!\n" << endl;
+}
+
+void testTranspositionTable() {
+    cout << "TEST 9: Transposition Table" << endl;
+    printSeparator();
+    
+    cout << "Comparing searches with and without the table..." << endl;
+    
+    uint8_t openings[][4] = {{3, 0, 0, 0}, {4, 4, 0, 0}, {1, 7, 4, 4}, {4, 3, 5, 6}};
+    for (uint8_t i = 0; i < 4; i++) {
+        Connect4Board board;
+        Player player = Player::FIRST;
+        for (uint8_t j = 0; j < 4 && openings[i][j] > 0; j++) {
+            board.makeMove(openings[i][j] - 1, player);
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+        
+        for (uint8_t depth = 1; depth <= 7; depth++) {
+            Connect4AI withTable;
+            Connect4AI withoutTable;
+            withTable.getTranspositionTable()->clear();
+            withoutTable.setTranspositionTable(nullptr);
+            
+            if (withTable.calculateBestMove(board, player, depth) != withoutTable.calculateBestMove(board, player, depth)) {
+                throw runtime_error("Transposition table changed the best move");
+            }
+        }
+    }
+    
+    cout << "✓ Same best moves with and without the table" << endl;
+    cout << "✓ Test 9 passed!\n" << endl;
+}
+
+void testTimedSearch() {
+    cout << "TEST 10: Time-Budgeted Search" << endl;
+    printSeparator();
+    
+    const uint32_t budgets[] = {1, 20, 100};
+    for (uint8_t i = 0; i < 3; i++) {
+        Connect4 game;
+        game.playMove(4, Player::FIRST);
+        
+        auto start = chrono::high_resolution_clock::now();
+        uint8_t move = game.calculateBestMoveTimed(Player::SECOND, budgets[i]);
+        auto end = chrono::high_resolution_clock::now();
+        auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
+        
+        cout << "Budget " << budgets[i] << " ms: best move = " << (int)move
+             << " (took " << duration.count() << " ms)" << endl;
+        
+        if (move < 1 || move > 7) {
+            throw runtime_error("Timed search returned no move");
+        }
+        // Generous margin for loaded machines: a search ignoring its budget
+        // from the second ply runs for far longer than a second
+        if (duration.count() > static_cast<long>(budgets[i]) + 1000) {
+            throw runtime_error("Timed search exceeded its budget");
+        }
+    }
+    
+    cout << "\n✓ Test 10 passed!\n" << endl;
+}
+
+void testParallelSearch() {
+    cout << "TEST 11: Parallel Search" << endl;
+    printSeparator();
+    
+    for (uint8_t threads = 1; threads <= 4; threads++) {
+        Connect4 game;
+        game.setAIThreads(threads);
+        game.playMove(4, Player::FIRST);
+        game.playMove(4, Player::SECOND);
+        
+        auto start = chrono::high_resolution_clock::now();
+        uint8_t move = game.calculateBestMove(Player::FIRST, 8);
+        uint8_t timedMove = game.calculateBestMoveTimed(Player::FIRST, 20);
+        auto end = chrono::high_resolution_clock::now();
+        auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
+        
+        cout << (int)threads << " thread(s): best move = " << (int)move
+             << ", timed = " << (int)timedMove << " (took " << duration.count() << " ms)" << endl;
+        
+        if (!game.isValidMove(move) || !game.isValidMove(timedMove)) {
+            throw runtime_error("Parallel search returned an invalid move");
+        }
+    }
+    
+    cout << "\n✓ Test 11 passed!\n" << endl;
+}
+
+// Window-by-window evaluation, the reference for the bitboard rescan
+static int32_t scanWindows(const Connect4BitBoard& board, Player player,
+                           const Connect4EvalWeights& weights = Connect4Evaluator::defaultWeights()) {
+    const int8_t steps[4][2] = {{0, 1}, {1, 0}, {1, 1}, {-1, 1}};
+    int32_t score = 0;
+    for (uint8_t row = 0; row < BOARD_ROWS; row++) {
+        if (board.getCell(row, BOARD_COLS / 2) == player) score += weights.center;
+    }
+    for (uint8_t d = 0; d < 4; d++) {
+        for (int8_t row = 0; row < BOARD_ROWS; row++) {
+            for (int8_t col = 0; col < BOARD_COLS; col++) {
+                int8_t endRow = row + (CONNECT_WIN - 1) * steps[d][0];
+                int8_t endCol = col + (CONNECT_WIN - 1) * steps[d][1];
+                if (endRow < 0 || endRow >= BOARD_ROWS || endCol >= BOARD_COLS) continue;
+                
+                uint8_t mine = 0;
+                uint8_t theirs = 0;
+                for (uint8_t k = 0; k < CONNECT_WIN; k++) {
+                    Player cell = board.getCell(row + k * steps[d][0], col + k * steps[d][1]);
+                    if (cell == player) mine++;
+                    else if (cell != Player::NONE) theirs++;
+                }
+                score += Connect4Evaluator::evaluateWindow(mine, theirs, weights);
+            }
+        }
+    }
+    return score;
+}
+
+void testIncrementalEvaluation() {
+    cout << "TEST 12: Incremental Evaluation" << endl;
+    printSeparator();
+    
+    cout << "Comparing incremental scores with full rescans..." << endl;
+    
+    uint32_t seed = 777;
+    for (int gameIndex = 0; gameIndex < 100; gameIndex++) {
+        Connect4BitBoard board;
+        Connect4Evaluator evaluator;
+        Player player = Player::FIRST;
+        uint8_t history[BOARD_ROWS * BOARD_COLS];
+        uint8_t played = 0;
+        
+        while (!board.isGameOver()) {
+            seed = seed * 1103515245 + 12345;
+            uint8_t col = (seed >> 16) % BOARD_COLS;
+            uint8_t row = board.getColumnHeight(col);
+            if (!board.makeMove(col, player)) continue;
+            evaluator.addStone(row, col, player);
+            history[played++] = col;
+            
+            for (uint8_t p = 1; p <= 2; p++) {
+                Player view = static_cast<Player>(p);
+                if (evaluator.getScore(view) != Connect4Evaluator::evaluate(board, view)) {
+                    throw runtime_error("Incremental evaluation differs after a move");
+                }
+                if (Connect4Evaluator::evaluate(board, view) != scanWindows(board, view)) {
+                    throw runtime_error("Bitboard evaluation differs from a window scan");
+                }
+            }
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+        
+        // Unwind the game: every score must return to the empty board's
+        while (played > 0) {
+            uint8_t col = history[--played];
+            uint8_t row = board.getColumnHeight(col) - 1;
+            evaluator.removeStone(row, col, board.getCell(row, col));
+            board.undoMove(col);
+            
+            if (evaluator.getScore(Player::FIRST) != Connect4Evaluator::evaluate(board, Player::FIRST)) {
+                throw runtime_error("Incremental evaluation differs after an undo");
+            }
+        }
+    }
+    
+    cout << "✓ Incremental scores match on 100 games" << endl;
+    cout << "✓ Bitboard rescans match window-by-window scores" << endl;
+    cout << "✓ Test 12 passed!\n" << endl;
+}
+
+void testOpeningBook() {
+    cout << "TEST 13: Opening Book" << endl;
+    printSeparator();
+    
+    // Book: empty board -> column 1, after FIRST plays column 4 -> column 7
+    Connect4BitBoard afterCenter;
+    afterCenter.makeMove(3, Player::FIRST);
+    
+    uint8_t bytes[Connect4OpeningBook::HEADER_SIZE + 2 * Connect4OpeningBook::RECORD_SIZE];
+    Connect4OpeningBook::writeHeader(bytes, 2);
+    Connect4OpeningBook::writeRecord(bytes + Connect4OpeningBook::HEADER_SIZE, Connect4BitBoard().getCanonicalKey(), 0);
+    Connect4OpeningBook::writeRecord(bytes + Connect4OpeningBook::HEADER_SIZE + Connect4OpeningBook::RECORD_SIZE,
+                                     afterCenter.getCanonicalKey(), 6);
+    
+    Connect4OpeningBook book;
+    if (!book.load(bytes, sizeof(bytes)) || book.getCount() != 2) {
+        throw runtime_error("Opening book failed to load");
+    }
+    
+    Connect4 game;
+    game.setOpeningBook(&book);
+    
+    auto start = chrono::high_resolution_clock::now();
+    uint8_t move = game.calculateBestMove(Player::FIRST, 12);
+    auto end = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
+    cout << "Book move on empty board: column " << (int)move << " (took " << duration.count() << " us)" << endl;
+    if (move != 1) {
+        throw runtime_error("Book move not used on the empty board");
+    }
+    
+    game.playMove(4, Player::FIRST);
+    if (game.calculateBestMoveTimed(Player::SECOND, 1000) != 7) {
+        throw runtime_error("Book move not used after the first move");
+    }
+    
+    // FIRST is not the side to move here, so the book must be ignored
+    if (game.calculateBestMove(Player::FIRST, 1) == 7) {
+        throw runtime_error("Book move used for the wrong side");
+    }
+    
+    cout << "✓ Book moves returned without searching" << endl;
+    
+    // 8x7 keys take 63 bits: records grow to 9 bytes
+    const uint8_t wideSize = connect4BookRecordSize(BasicConnect4BitBoard<8, 7, 4>::KEY_BITS);
+    uint8_t wide[Connect4OpeningBook::HEADER_SIZE + 2 * Connect4OpeningBook::MAX_RECORD_SIZE];
+    uint64_t highKey = (UINT64_C(1) << 62) | 5;
+    Connect4OpeningBook::writeHeader(wide, 2, 8, 7, 4);
+    Connect4OpeningBook::writeRecord(wide + Connect4OpeningBook::HEADER_SIZE,
+                                     BasicConnect4BitBoard<8, 7, 4>().getCanonicalKey(), 3, wideSize);
+    Connect4OpeningBook::writeRecord(wide + Connect4OpeningBook::HEADER_SIZE + wideSize, highKey, 6, wideSize);
+    
+    Connect4OpeningBook wideBook;
+    uint32_t wideBytes = Connect4OpeningBook::HEADER_SIZE + 2 * wideSize;
+    if (book.load(wide, wideBytes) || !wideBook.load(wide, wideBytes, 8, 7, 4) || wideBook.getCount() != 2) {
+        throw runtime_error("Book geometry not checked");
+    }
+    if (wideSize != 9 || wideBook.lookup(BasicConnect4BitBoard<8, 7, 4>()) != 3 || wideBook.lookup(highKey) != 6 ||
+        wideBook.lookup(Connect4BitBoard()) != -1) {
+        throw runtime_error("Wide book records not read back");
+    }
+    cout << "✓ Books refused for another geometry, 9-byte records on 8x7" << endl;
+    
+    // Lookups check the whole geometry: 7x6 and 5x8 keys both take 48 bits,
+    // and 6x7 connect 3 has the keys of the standard board
+    uint8_t other[Connect4OpeningBook::HEADER_SIZE + Connect4OpeningBook::RECORD_SIZE];
+    uint64_t otherKey = BasicConnect4BitBoard<5, 8, 4>().getCanonicalKey();
+    Connect4OpeningBook::writeHeader(other, 2, 7, 6, 4);
+    Connect4OpeningBook::writeRecord(other + Connect4OpeningBook::HEADER_SIZE, otherKey, 2);
+    Connect4OpeningBook otherBook;
+    if (!otherBook.load(other, sizeof(other), 7, 6, 4) || otherBook.lookup(otherKey) != 2 ||
+        otherBook.lookup(BasicConnect4BitBoard<5, 8, 4>()) != -1) {
+        throw runtime_error("7x6 book answered a 5x8 board");
+    }
+    if (!book.load(bytes, sizeof(bytes)) || book.lookup(Connect4BitBoard()) != 0 ||
+        book.lookup(BasicConnect4BitBoard<6, 7, 3>()) != -1) {
+        throw runtime_error("Connect 4 book answered a connect 3 board");
+    }
+    cout << "✓ Boards of another geometry with keys of the same width not answered" << endl;
+    cout << "✓ Test 13 passed!\n" << endl;
+}
+
+void testSearchStats() {
+    cout << "TEST 14: Search Statistics" << endl;
+    printSeparator();
+    
+    Connect4AI ai;
+    Connect4Board board;
+    board.makeMove(3, Player::FIRST);
+    
+    ai.getTranspositionTable()->clear();
+    ai.calculateBestMove(board, Player::SECOND, 7);
+    const SearchStats& stats = ai.getSearchStats();
+    
+    cout << "Nodes: " << stats.nodes << ", leaves: " << stats.leafEvaluations
+         << ", cutoffs: " << stats.betaCutoffs << " (first move " << stats.firstMoveCutoffRate() * 100 << "%)"
+         << ", table hits: " << stats.tableHitRate() * 100 << "%"
+         << ", max depth: " << (int)stats.maxDepth << endl;
+    
+#if CONNECT4_SEARCH_STATS
+    if (stats.nodes != ai.getNodeCount() || stats.leafEvaluations == 0 || stats.betaCutoffs == 0) {
+        throw runtime_error("Search statistics not collected");
+    }
+    if (stats.maxDepth != 7 || stats.iterations != 1 || stats.firstMoveCutoffs > stats.betaCutoffs) {
+        throw runtime_error("Search statistics inconsistent");
+    }
+    
+    ai.calculateBestMoveTimed(board, Player::SECOND, 20);
+    if (ai.getSearchStats().iterations == 0) {
+        throw runtime_error("Iteration times not collected");
+    }
+#endif
+    
+    cout << "✓ Test 14 passed!\n" << endl;
+}
+
+void testBatchAnalysis() {
+    cout << "TEST 15: Batch Analysis" << endl;
+    printSeparator();
+    
+    const char* positions[] = {"", "4", "4453", "4153446745253553122", "48", "4444444", "425646665465425422453325233"};
+    const bool expectedValid[] = {true, true, true, true, false, false, true};
+    const size_t count = sizeof(positions) / sizeof(positions[0]);
+    
+    // Repeat the list so several chunks get spread (and stolen) across threads
+    vector<const char*> batch;
+    for (int i = 0; i < 20; i++) {
+        batch.insert(batch.end(), positions, positions + count);
+    }
+    vector<Connect4AnalysisResult> results(batch.size());
+    
+    Connect4BatchAnalyzer analyzer(3, 5, 12);
+    auto start = chrono::high_resolution_clock::now();
+    analyzer.analyze(&batch[0], batch.size(), &results[0]);
+    auto end = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
+    
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (results[i].valid != expectedValid[i % count]) {
+            throw runtime_error("Batch analysis validity differs");
+        }
+        if (!results[i].valid) continue;
+        
+        Connect4BitBoard board;
+        Connect4BatchAnalyzer::replay(batch[i], board);
+        if (!board.isValidMove(results[i].bestMove)) {
+            throw runtime_error("Batch analysis returned an invalid move");
+        }
+    }
+    
+    cout << "✓ " << batch.size() << " positions analyzed on " << (int)analyzer.getThreads()
+         << " threads (took " << duration.count() << " ms)" << endl;
+    cout << "✓ Test 15 passed!\n" << endl;
+}
+
+void testThreatDetection() {
+    cout << "TEST 16: Threat Detection" << endl;
+    printSeparator();
+    
+    // FIRST threatens the bottom cell of column 4: SECOND must block there
+    Connect4BitBoard board;
+    board.makeMove(0, Player::FIRST);
+    board.makeMove(0, Player::SECOND);
+    board.makeMove(1, Player::FIRST);
+    board.makeMove(1, Player::SECOND);
+    board.makeMove(2, Player::FIRST);
+    
+    if (!board.canWinNext(Player::FIRST) || board.canWinNext(Player::SECOND)) {
+        throw runtime_error("Immediate win not detected");
+    }
+    if (board.getNonLosingCells(Player::SECOND) != (board.getPlayableCells() & Connect4BitBoard::columnMask(3))) {
+        throw runtime_error("Forced block not detected");
+    }
+    cout << "✓ Forced block detected" << endl;
+    
+    // FIRST threatens the second cell of columns 3 and 7: SECOND must not
+    // play below them
+    board.reset();
+    board.makeMove(3, Player::SECOND);
+    board.makeMove(4, Player::FIRST);
+    board.makeMove(5, Player::SECOND);
+    board.makeMove(3, Player::FIRST);
+    board.makeMove(4, Player::FIRST);
+    board.makeMove(5, Player::FIRST);
+    
+    uint64_t expected = board.getPlayableCells() & ~Connect4BitBoard::columnMask(2) & ~Connect4BitBoard::columnMask(6);
+    if (board.getNonLosingCells(Player::SECOND) != expected) {
+        throw runtime_error("Moves under a threat not excluded");
+    }
+    cout << "✓ Moves under opponent threats excluded" << endl;
+    
+    // The AI blocks instead of playing elsewhere
+    Connect4 game;
+    game.playMove(1, Player::FIRST);
+    game.playMove(1, Player::SECOND);
+    game.playMove(2, Player::FIRST);
+    game.playMove(2, Player::SECOND);
+    game.playMove(3, Player::FIRST);
+    if (game.calculateBestMove(Player::SECOND, 6) != 4) {
+        throw runtime_error("AI did not block the threat");
+    }
+    cout << "✓ AI blocks the threat" << endl;
+    
+    cout << "✓ Test 16 passed!\n" << endl;
+}
+
+void testSearchAlgorithms() {
+    cout << "TEST 17: Search Algorithms" << endl;
+    printSeparator();
+    
+    const char* positions[] = {"", "4453", "4153446745253553122", "425646665465425422453325233"};
+    const SearchAlgorithm algorithms[] = {SearchAlgorithm::MINIMAX, SearchAlgorithm::PVS, SearchAlgorithm::MTDF};
+    const char* names[] = {"Minimax", "PVS", "MTD(f)"};
+    
+    Connect4AI ai;
+    for (uint8_t p = 0; p < 4; p++) {
+        Connect4BitBoard board;
+        Connect4BatchAnalyzer::replay(positions[p], board);
+        Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+        
+        // Every variant must find the minimax score, with or without a table
+        int32_t expected = 0;
+        for (uint8_t a = 0; a < 3; a++) {
+            for (uint8_t withTable = 0; withTable < 2; withTable++) {
+                ai.setSearchAlgorithm(algorithms[a]);
+                ai.setTranspositionTable(withTable ? &Connect4TranspositionTable::shared() : nullptr);
+                if (withTable) Connect4TranspositionTable::shared().clear();
+                
+                int8_t move = ai.calculateBestMove(board, toMove, 7);
+                if (move < 0 || !board.isValidMove(move)) {
+                    throw runtime_error(string(names[a]) + " returned an invalid move");
+                }
+                if (a == 0 && withTable == 0) {
+                    expected = ai.getLastScore();
+                } else if (ai.getLastScore() != expected) {
+                    throw runtime_error(string(names[a]) + " score differs from minimax");
+                }
+                if (withTable) {
+                    cout << "  " << (positions[p][0] ? positions[p] : "(empty)") << " " << names[a]
+                         << ": column " << (int)move + 1 << ", " << ai.getNodeCount() << " nodes" << endl;
+                }
+            }
+        }
+    }
+    ai.setTranspositionTable(&Connect4TranspositionTable::shared());
+    cout << "✓ Minimax, PVS and MTD(f) agree" << endl;
+    
+    // Selectable from the game API too
+    Connect4 game;
+    game.setAIAlgorithm(SearchAlgorithm::PVS);
+    game.playMove(1, Player::FIRST);
+    game.playMove(1, Player::SECOND);
+    game.playMove(2, Player::FIRST);
+    game.playMove(2, Player::SECOND);
+    game.playMove(3, Player::FIRST);
+    if (game.calculateBestMove(Player::SECOND, 6) != 4) {
+        throw runtime_error("PVS did not block the threat");
+    }
+    cout << "✓ PVS selectable on Connect4" << endl;
+    
+    cout << "✓ Test 17 passed!\n" << endl;
+}
+
+void testSolver() {
+    cout << "TEST 18: Solver" << endl;
+    printSeparator();
+    
+    Connect4AI ai;
+    Connect4BitBoard board;
+    
+    // The solver recurses one ply per empty cell: with a smaller
+    // CONNECT4_MAX_PLY, positions with more empty cells are left unsolved
+    if (Connect4AI::MAX_PLY < Connect4AI::CELLS) {
+        Connect4BatchAnalyzer::replay("4455", board);
+        if (ai.solve(board, Player::FIRST).bestMove != -1) {
+            throw runtime_error("Position beyond MAX_PLY solved");
+        }
+        Connect4BatchAnalyzer::replay("425646665465425422453325233", board);
+        if (Connect4AI::CELLS - board.getMoveCount() <= Connect4AI::MAX_PLY &&
+            ai.solve(board, Player::SECOND).bestMove < 0) {
+            throw runtime_error("Endgame within MAX_PLY not solved");
+        }
+        cout << "✓ Only positions with at most " << (int)Connect4AI::MAX_PLY << " empty cells solved" << endl;
+        cout << "✓ Test 18 passed!\n" << endl;
+        return;
+    }
+    
+    // FIRST completes an open three on the bottom row: win with its 4th stone
+    Connect4BatchAnalyzer::replay("4455", board);
+    Connect4Solution solution = ai.solve(board, Player::FIRST);
+    if (solution.score != 18 || solution.distance != 3 ||
+        (solution.bestMove != 2 && solution.bestMove != 5)) {
+        throw runtime_error("Open three not solved as a win in 3");
+    }
+    cout << "✓ Win in 3 plies found (column " << (int)solution.bestMove + 1 << ")" << endl;
+    
+    // Both moves lose: SECOND is lost on the next move
+    Connect4BatchAnalyzer::replay("44455554221", board);
+    solution = ai.solve(board, Player::SECOND);
+    if (solution.score >= 0 || solution.distance != 2 || solution.bestMove < 0) {
+        throw runtime_error("Lost position not solved");
+    }
+    cout << "✓ Loss in 2 plies found" << endl;
+    
+    // Exact results agree with a search to the end of the game, with and
+    // without the table, and the chosen move keeps the score
+    const char* positions[] = {"425646665465425422453325233", "4153446745253553122",
+                               "55534633336744477544553"};
+    for (uint8_t i = 0; i < 3; i++) {
+        Connect4BatchAnalyzer::replay(positions[i], board);
+        Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+        Player opponent = (toMove == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        uint8_t remaining = BOARD_ROWS * BOARD_COLS - board.getMoveCount();
+        
+        solution = ai.solve(board, toMove);
+        ai.setTranspositionTable(nullptr);
+        Connect4Solution untabled = ai.solve(board, toMove);
+        ai.setTranspositionTable(&Connect4TranspositionTable::shared());
+        if (untabled.score != solution.score || untabled.distance != solution.distance) {
+            throw runtime_error("Solver result depends on the table");
+        }
+        
+        ai.calculateBestMove(board, toMove, remaining);
+        int32_t searched = ai.getLastScore();
+        int8_t outcome = searched >= Connect4Evaluator::WIN_SCORE ? 1 :
+                         searched <= -Connect4Evaluator::WIN_SCORE ? -1 : 0;
+        if (outcome != (solution.score > 0) - (solution.score < 0)) {
+            throw runtime_error("Solver disagrees with a full-depth search");
+        }
+        
+        board.makeMove(solution.bestMove, toMove);
+        Connect4Solution reply = ai.solve(board, opponent);
+        if (-reply.score != solution.score || reply.distance + 1 != solution.distance) {
+            throw runtime_error("Best move does not keep the score");
+        }
+        cout << "  " << positions[i] << ": score " << (int)solution.score << " in "
+             << (int)solution.distance << " plies, " << ai.getNodeCount() << " nodes" << endl;
+    }
+    cout << "✓ Exact results agree with full-depth search" << endl;
+    
+    // A solved book of the replies ends the solve one ply down (no table, so
+    // node counts compare)
+    ai.setTranspositionTable(nullptr);
+    Connect4BatchAnalyzer::replay(positions[1], board);
+    Connect4Solution unbooked = ai.solve(board, Player::SECOND);
+    uint64_t unbookedNodes = ai.getNodeCount();
+    map<uint64_t, vector<uint8_t> > replies;
+    for (uint8_t col = 0; col < BOARD_COLS; col++) {
+        if (!board.isValidMove(col)) continue;
+        Connect4BitBoard child = board;
+        child.makeMove(col, Player::SECOND);
+        Connect4Solution childSolution = ai.solve(child, Player::FIRST);
+        if (childSolution.bestMove < 0) continue;
+        uint8_t column = child.isMirrored() ? Connect4BitBoard::mirrorColumn(childSolution.bestMove) :
+                                              childSolution.bestMove;
+        vector<uint8_t>& record = replies[child.getCanonicalKey()];
+        record.resize(Connect4OpeningBook::SOLVED_RECORD_SIZE);
+        Connect4OpeningBook::writeSolvedRecord(&record[0], child.getCanonicalKey(), column, childSolution.score);
+    }
+    vector<uint8_t> solvedBytes(Connect4OpeningBook::HEADER_SIZE);
+    Connect4OpeningBook::writeHeader(&solvedBytes[0], board.getMoveCount() + 1, BOARD_ROWS, BOARD_COLS,
+                                     CONNECT_WIN, true);
+    for (map<uint64_t, vector<uint8_t> >::iterator it = replies.begin(); it != replies.end(); ++it) {
+        solvedBytes.insert(solvedBytes.end(), it->second.begin(), it->second.end());
+    }
+    Connect4OpeningBook solvedBook;
+    int8_t bookedScore;
+    Connect4BitBoard bookedChild = board;
+    bookedChild.makeMove(unbooked.bestMove, Player::SECOND);
+    if (!solvedBook.load(&solvedBytes[0], static_cast<uint32_t>(solvedBytes.size())) || !solvedBook.isSolved() ||
+        !solvedBook.lookupScore(bookedChild, bookedScore) || bookedScore != -unbooked.score) {
+        throw runtime_error("Solved book scores not read back");
+    }
+    ai.setOpeningBook(&solvedBook);
+    Connect4Solution booked = ai.solve(board, Player::SECOND);
+    ai.setOpeningBook(nullptr);
+    ai.setTranspositionTable(&Connect4TranspositionTable::shared());
+    if (booked.score != unbooked.score || booked.distance != unbooked.distance ||
+        ai.getNodeCount() >= unbookedNodes) {
+        throw runtime_error("Solver did not stop at the solved book");
+    }
+    cout << "✓ Solved book: " << ai.getNodeCount() << " nodes instead of " << unbookedNodes << endl;
+    
+    // Perfect play through the game API
+    Connect4 game;
+    game.setAIPerfectPlay(true);
+    game.playMove(4, Player::FIRST);
+    game.playMove(4, Player::SECOND);
+    game.playMove(5, Player::FIRST);
+    game.playMove(5, Player::SECOND);
+    uint8_t move = game.calculateBestMove(Player::FIRST, 1);
+    if (move != 3 && move != 6) {
+        throw runtime_error("Perfect play missed the winning move");
+    }
+    cout << "✓ Perfect play selectable on Connect4" << endl;
+    
+    cout << "✓ Test 18 passed!\n" << endl;
+}
+
+void testBoardGeometry() {
+    cout << "TEST 19: Board Geometry" << endl;
+    printSeparator();
+    
+    // Connect-5 on the standard board: four in a row is not a win
+    BasicConnect4BitBoard<6, 7, 5> connect5;
+    for (uint8_t c = 0; c < 4; c++) {
+        connect5.makeMove(c, Player::FIRST);
+        connect5.makeMove(c, Player::SECOND);
+    }
+    if (connect5.hasWinner() || !connect5.canWinNext(Player::FIRST)) {
+        throw runtime_error("Connect-5 alignment rules wrong");
+    }
+    connect5.makeMove(4, Player::FIRST);
+    if (connect5.getWinner() != Player::FIRST) {
+        throw runtime_error("Connect-5 win not detected");
+    }
+    cout << "✓ Connect-5 wins with five stones" << endl;
+    
+    // 8x7: columns hold 8 stones, the AI sees the same threats
+    BasicConnect4<8, 7, 4> tall;
+    for (uint8_t i = 0; i < 8; i++) {
+        if (!tall.playMove(1, i % 2 ? Player::FIRST : Player::SECOND)) {
+            throw runtime_error("8-row column rejected a stone");
+        }
+    }
+    if (tall.isValidMove(1) || !tall.isValidMove(7) || tall.isValidMove(8)) {
+        throw runtime_error("8x7 move validation wrong");
+    }
+    tall.playMove(2, Player::FIRST);
+    tall.playMove(2, Player::SECOND);
+    tall.playMove(3, Player::FIRST);
+    tall.playMove(3, Player::SECOND);
+    tall.playMove(4, Player::FIRST);
+    if (tall.calculateBestMove(Player::SECOND, 6) != 5) {
+        throw runtime_error("8x7 AI did not block the threat");
+    }
+    cout << "✓ 8x7 board and AI" << endl;
+    
+    // 7x8 uses all 64 bits of the bitboard: search and solver still agree
+    BasicConnect4AI<7, 8, 4> wideAI;
+    BasicConnect4BitBoard<7, 8, 4> wide;
+    const uint8_t moves[] = {3, 3, 4, 4};
+    for (uint8_t i = 0; i < 4; i++) {
+        wide.makeMove(moves[i], i % 2 ? Player::SECOND : Player::FIRST);
+    }
+    int8_t move = wideAI.calculateBestMove(wide, Player::FIRST, 6);
+    Connect4Solution solution = wideAI.solve(wide, Player::FIRST);
+    bool solvable = BasicConnect4AI<7, 8, 4>::MAX_PLY >= BasicConnect4AI<7, 8, 4>::CELLS - 4;
+    if ((move != 2 && move != 5) || (!solvable && solution.bestMove != -1) ||
+        (solvable && (solution.score <= 0 || solution.distance != 3 ||
+                      (solution.bestMove != 2 && solution.bestMove != 5)))) {
+        throw runtime_error("7x8 AI missed the open two");
+    }
+    cout << "✓ 7x8 search and solver" << endl;
+    
+    // 9x7 needs 70 bits: the top of the last column lies past bit 64
+    BasicConnect4<9, 7, 4> large;
+    const Player column7[] = {Player::SECOND, Player::SECOND, Player::FIRST, Player::SECOND,
+                              Player::FIRST, Player::FIRST, Player::FIRST};
+    for (uint8_t i = 0; i < 7; i++) {
+        large.playMove(7, column7[i]);
+    }
+    if (large.calculateBestMove(Player::SECOND, 4) != 7) {
+        throw runtime_error("9x7 AI did not block the threat in the high bits");
+    }
+    
+    // A whole game between two AIs, checked against the array board
+    BasicConnect4<9, 7, 4> game;
+    BasicConnect4BitBoard<9, 7, 4> shadow;
+    Player player = Player::FIRST;
+    while (!game.isGameOver()) {
+        uint8_t column = game.calculateBestMove(player, 5);
+        if (!game.playMove(column, player) || !shadow.makeMove(column - 1, player)) {
+            throw runtime_error("9x7 AI played an invalid move");
+        }
+        if (shadow.getState() != game.getGameState()) {
+            throw runtime_error("9x7 bitboard and array board disagree");
+        }
+        player = game.getOpponent(player);
+    }
+    cout << "✓ 9x7 game over 128-bit bitboards (" << (int)shadow.getMoveCount() << " moves)" << endl;
+    
+    cout << "✓ Test 19 passed!\n" << endl;
+}
+
+void testSymmetry() {
+    cout << "TEST 20: Mirror Symmetry" << endl;
+    printSeparator();
+    
+    // A game and its mirror image, played move by move
+    Connect4BitBoard board;
+    Connect4BitBoard mirror;
+    const uint8_t moves[] = {0, 3, 1, 1, 5, 2, 6, 4};
+    for (uint8_t i = 0; i < 8; i++) {
+        Player player = i % 2 ? Player::SECOND : Player::FIRST;
+        board.makeMove(moves[i], player);
+        mirror.makeMove(Connect4BitBoard::mirrorColumn(moves[i]), player);
+        if (board.getMirrorKey() != mirror.getKey() || board.getCanonicalKey() != mirror.getCanonicalKey() ||
+            board.isMirrored() == mirror.isMirrored()) {
+            throw runtime_error("Mirror key not maintained");
+        }
+    }
+    board.undoMove(4);
+    board.undoMove(6);
+    mirror.undoMove(2);
+    mirror.undoMove(0);
+    if (board.getMirrorKey() != mirror.getKey() || board.isSymmetric()) {
+        throw runtime_error("Mirror key not restored by undo");
+    }
+    Connect4BitBoard center;
+    center.makeMove(3, Player::FIRST);
+    center.makeMove(3, Player::SECOND);
+    if (!center.isSymmetric() || center.isMirrored()) {
+        throw runtime_error("Symmetric position not detected");
+    }
+    cout << "✓ Canonical key maintained incrementally" << endl;
+    
+    // One book record serves a position and its mirror image
+    Connect4BitBoard left;
+    left.makeMove(0, Player::FIRST);
+    Connect4BitBoard right;
+    right.makeMove(6, Player::FIRST);
+    const Connect4BitBoard& stored = left.isMirrored() ? right : left;
+    uint8_t bytes[Connect4OpeningBook::HEADER_SIZE + Connect4OpeningBook::RECORD_SIZE];
+    Connect4OpeningBook::writeHeader(bytes, 1);
+    Connect4OpeningBook::writeRecord(bytes + Connect4OpeningBook::HEADER_SIZE, stored.getCanonicalKey(),
+                                     &stored == &left ? 1 : 5);
+    Connect4OpeningBook book;
+    book.load(bytes, sizeof(bytes));
+    if (book.lookup(left) != 1 || book.lookup(right) != 5) {
+        throw runtime_error("Book move not mirrored");
+    }
+    cout << "✓ Book record shared by mirror positions" << endl;
+    
+    // A search of the mirror image reuses the table entries of the first
+    Connect4AI ai;
+    ai.getTranspositionTable()->clear();
+    int8_t move = ai.calculateBestMove(board, Player::SECOND, 9);
+    uint32_t nodes = ai.getNodeCount();
+    int8_t mirrorMove = ai.calculateBestMove(mirror, Player::SECOND, 9);
+    cout << "Nodes: " << nodes << " then " << ai.getNodeCount() << " for the mirror image" << endl;
+    if (mirrorMove != Connect4BitBoard::mirrorColumn(move) || ai.getNodeCount() >= nodes) {
+        throw runtime_error("Mirror position did not reuse the table");
+    }
+    
+    // Symmetric roots only search the left half (ties go to the first move)
+    if (ai.calculateBestMove(center, Player::FIRST, 8) > 3) {
+        throw runtime_error("Mirror move searched in a symmetric position");
+    }
+    cout << "✓ Table entries and root moves shared with the mirror image" << endl;
+    
+    cout << "✓ Test 20 passed!\n" << endl;
+}
+
+void testGameRecords() {
+    cout << "TEST 21: Game Records" << endl;
+    printSeparator();
+    
+    // Text form
+    Connect4GameRecord won;
+    Connect4GameRecord scored;
+    Connect4GameRecord empty;
+    Connect4GameRecord bad;
+    if (!won.parse("4455667 1-0") || won.moveCount != 7 || won.result != GameState::FIRST_WINS ||
+        !empty.parse("*") || empty.moveCount != 0 || bad.parse("4459 1-0") || bad.parse("44 2-0")) {
+        throw runtime_error("Game text not parsed");
+    }
+    char text[Connect4GameRecord::MAX_TEXT_SIZE];
+    won.format(text, sizeof(text));
+    if (strcmp(text, "4455667 1-0") != 0) {
+        throw runtime_error("Game text not formatted");
+    }
+    const int32_t scores[] = {3, -120, 100004, -100002};
+    const uint8_t moves[] = {3, 3, 2, 4};
+    for (uint8_t i = 0; i < 4; i++) {
+        scored.addMove(moves[i], scores[i]);
+    }
+    cout << "✓ Text form: " << text << endl;
+    
+    // Binary records, streamed through a buffer that ends mid-record
+    uint8_t bytes[64];
+    Connect4GameWriter writer(bytes, sizeof(bytes));
+    if (!writer.write(won) || !writer.write(scored) || !writer.write(empty) ||
+        writer.getSize() != Connect4GameWriter::recordSize(won) + Connect4GameWriter::recordSize(scored) + 2 ||
+        Connect4GameWriter::recordSize(won) != 5) {
+        throw runtime_error("Game records not written");
+    }
+    
+    Connect4GameRecord record;
+    Connect4GameReader reader(bytes, Connect4GameWriter::recordSize(won) + 3);
+    if (reader.next(record) != Connect4ReadStatus::OK || reader.next(record) != Connect4ReadStatus::NEED_MORE ||
+        reader.getRemaining() != 3) {
+        throw runtime_error("Partial record not left for the next block");
+    }
+    Connect4BitBoard board;
+    if (!record.replay(board) || board.getWinner() != Player::FIRST) {
+        throw runtime_error("Won game not replayed");
+    }
+    reader.setData(bytes + reader.getOffset(), writer.getSize() - reader.getOffset());
+    if (reader.next(record) != Connect4ReadStatus::OK || record.moveCount != 4 || !record.hasScores) {
+        throw runtime_error("Scored record not read");
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        if (record.moves[i] != moves[i] || record.scores[i] != scores[i]) {
+            throw runtime_error("Moves or scores not restored");
+        }
+    }
+    if (reader.next(record) != Connect4ReadStatus::OK || record.moveCount != 0 ||
+        reader.next(record) != Connect4ReadStatus::NEED_MORE || reader.getRemaining() != 0) {
+        throw runtime_error("Empty record not read");
+    }
+    cout << "✓ Binary records streamed across blocks" << endl;
+    
+    // Illegal games and wrong results are caught on replay, corrupt data on read
+    Connect4Board arrayBoard;
+    bad.parse("1111111");
+    if (bad.replay(arrayBoard) || !won.replay(arrayBoard)) {
+        throw runtime_error("Replay legality not checked");
+    }
+    won.result = GameState::DRAW;
+    if (won.replay(arrayBoard)) {
+        throw runtime_error("Wrong result not detected");
+    }
+    bytes[1] = 0xF0;
+    reader.setData(bytes, writer.getSize());
+    if (reader.next(record) != Connect4ReadStatus::INVALID) {
+        throw runtime_error("Corrupt record not detected");
+    }
+    uint8_t header[Connect4GameRecord::HEADER_SIZE];
+    uint8_t rows, cols, win;
+    Connect4GameWriter::writeHeader(header);
+    if (!Connect4GameReader::readHeader(header, sizeof(header), rows, cols, win) ||
+        rows != BOARD_ROWS || cols != BOARD_COLS || win != CONNECT_WIN) {
+        throw runtime_error("File header not read");
+    }
+    cout << "✓ Illegal, mismatched and corrupt games rejected" << endl;
+    
+    cout << "✓ Test 21 passed!\n" << endl;
+}
+
+void testSessionManager() {
+    cout << "TEST 22: Session Manager" << endl;
+    printSeparator();
+    
+    Connect4SessionManager manager(100, 3, 12);
+    
+    // Handles stay valid until their game is destroyed, even when reused
+    Connect4SessionHandle first = manager.create();
+    Connect4SessionHandle second = manager.create();
+    if (first == Connect4SessionManager::INVALID_HANDLE || first == second || manager.getSessionCount() != 2) {
+        throw runtime_error("Sessions not created");
+    }
+    manager.destroy(first);
+    Connect4SessionHandle reused = manager.create();
+    if (manager.isValid(first) || !manager.isValid(reused) || manager.playMove(first, 4, Player::FIRST) ||
+        manager.getBoard(first) != nullptr) {
+        throw runtime_error("Stale handle still accepted");
+    }
+    if (manager.playMove(reused, 4, Player::NONE) || manager.getBoard(reused)->getMoveCount() != 0) {
+        throw runtime_error("Move without a player accepted");
+    }
+    manager.destroy(reused);
+    manager.destroy(second);
+    cout << "✓ Stale handles and moves without a player rejected" << endl;
+    
+    // Fill the pool: every game has FIRST threatening column 4, SECOND to move
+    vector<Connect4SessionHandle> games;
+    for (Connect4SessionHandle handle; (handle = manager.create()) != Connect4SessionManager::INVALID_HANDLE; ) {
+        games.push_back(handle);
+        manager.playMove(handle, 1, Player::FIRST);
+        manager.playMove(handle, 1, Player::SECOND);
+        manager.playMove(handle, 2, Player::FIRST);
+        manager.playMove(handle, 2, Player::SECOND);
+        manager.playMove(handle, 3, Player::FIRST);
+    }
+    if (games.size() != 100) {
+        throw runtime_error("Pool capacity not used");
+    }
+    
+    // One batch, with a request cancelled by a reset and one requested twice
+    for (size_t i = 0; i < games.size(); i++) {
+        if (!manager.requestMove(games[i], Player::SECOND, 6)) {
+            throw runtime_error("AI move not queued");
+        }
+    }
+    if (manager.requestMove(games[0], Player::SECOND, 6) || manager.playMove(games[0], 4, Player::SECOND)) {
+        throw runtime_error("Pending game accepted a second move");
+    }
+    manager.reset(games[1]);
+    manager.requestMove(games[1], Player::FIRST, 4);
+    
+    auto start = chrono::high_resolution_clock::now();
+    size_t played = manager.processRequests();
+    auto end = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::milliseconds>(end - start);
+    if (played != 100 || manager.processRequests() != 0) {
+        throw runtime_error("Batch size wrong");
+    }
+    for (size_t i = 0; i < games.size(); i++) {
+        if (i == 1) {
+            if (manager.getBoard(games[i])->getMoveCount() != 1) {
+                throw runtime_error("Reset game not played from the empty board");
+            }
+        } else if (manager.getLastAIMove(games[i]) != 4 || manager.getBoard(games[i])->getMoveCount() != 6) {
+            throw runtime_error("AI move not played in the session");
+        }
+    }
+    cout << "✓ " << played << " AI moves on " << (int)manager.getThreads() << " threads (took "
+         << duration.count() << " ms)" << endl;
+    
+    cout << "✓ Test 22 passed!\n" << endl;
+}
+
+void testResumableSearch() {
+    cout << "TEST 23: Resumable Search" << endl;
+    printSeparator();
+    
+    // Without tables, the last iteration scores the root like a plain
+    // alpha-beta search of the same depth, whatever the slice size
+    const char* positions[] = {"", "4453", "4153446745253553122", "425646665465425422453325233"};
+    Connect4AI ai;
+    ai.setTranspositionTable(nullptr);
+    Connect4Search search;
+    search.setTranspositionTable(nullptr);
+    for (uint8_t i = 0; i < 4; i++) {
+        Connect4BitBoard board;
+        Connect4BatchAnalyzer::replay(positions[i], board);
+        Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+        
+        ai.calculateBestMove(board, toMove, 6);
+        search.start(board, toMove, 6);
+        uint32_t steps = 1;
+        while (!search.step(1)) steps++;
+        int32_t sliced = search.getScore();
+        search.start(board, toMove, 6);
+        search.step(UINT32_MAX);
+        
+        if (sliced != ai.getLastScore() || search.getScore() != sliced || !board.isValidMove(search.result())) {
+            throw runtime_error("Resumable search score differs");
+        }
+        cout << "  " << (positions[i][0] ? positions[i] : "(empty)") << ": score " << sliced
+             << " in " << steps << " steps of 1 node" << endl;
+    }
+    cout << "✓ Same scores as a recursive search" << endl;
+    
+    // With the table: the move of the last completed iteration is available
+    // between slices, and forced results end the search early
+    Connect4Board board;
+    board.makeMove(0, Player::FIRST);
+    board.makeMove(0, Player::SECOND);
+    board.makeMove(1, Player::FIRST);
+    board.makeMove(1, Player::SECOND);
+    board.makeMove(2, Player::FIRST);
+    search.setTranspositionTable(&Connect4TranspositionTable::shared());
+    search.start(board, Player::SECOND, 12);
+    while (!search.step(100)) {
+        if (search.getDepth() > 0 && search.result() != 3) {
+            throw runtime_error("Threat not blocked between slices");
+        }
+    }
+    search.start(board, Player::FIRST, 12);
+    if (!search.step(1) || search.result() != 3 || search.getScore() < Connect4Evaluator::WIN_SCORE) {
+        throw runtime_error("Immediate win not found at once");
+    }
+    cout << "✓ Best move available between slices" << endl;
+    
+    cout << "✓ Test 23 passed!\n" << endl;
+}
+
+void testPondering() {
+    cout << "TEST 24: Principal Variation and Pondering" << endl;
+    printSeparator();
+    
+    // The line starts with the move returned and can be played out
+    Connect4BitBoard board;
+    Connect4BatchAnalyzer::replay("4453", board);
+    Connect4AI ai;
+    int8_t move = ai.calculateBestMove(board, Player::FIRST, 8);
+    int8_t line[42];
+    uint8_t length = ai.getPrincipalVariation(line, 42);
+    if (length < 2 || line[0] != move || line[1] != ai.getExpectedReply()) {
+        throw runtime_error("Principal variation does not start with the best move");
+    }
+    Connect4BitBoard played(board);
+    Player toMove = Player::FIRST;
+    cout << "  4453: ";
+    for (uint8_t i = 0; i < length; i++) {
+        if (!played.makeMove(static_cast<uint8_t>(line[i]), toMove)) {
+            throw runtime_error("Principal variation contains an invalid move");
+        }
+        toMove = (toMove == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        cout << (int)(line[i] + 1);
+    }
+    cout << endl;
+    cout << "✓ Principal variation of " << (int)length << " moves" << endl;
+    
+    // Expected reply played: the move comes from the background search
+    Connect4 game;
+    game.setAIPondering(true);
+    game.playMove(4, Player::FIRST);
+    uint8_t aiMove = game.calculateBestMove(Player::SECOND, 8);
+    uint8_t reply = game.getExpectedReply();
+    if (reply == 0) {
+        throw runtime_error("No expected reply");
+    }
+    game.playMove(aiMove, Player::SECOND);
+    game.playMove(reply, Player::FIRST);
+    Connect4 cold = game;
+    aiMove = game.calculateBestMove(Player::SECOND, 8);
+    if (game.getPonderHits() != 1 || !game.isValidMove(aiMove)) {
+        throw runtime_error("Expected reply not answered by pondering");
+    }
+    cout << "✓ Ponder hit: column " << (int)aiMove << " (cold search: column "
+         << (int)cold.calculateBestMove(Player::SECOND, 8) << ")" << endl;
+    
+    // Another reply stops the background search and searches normally
+    game.playMove(aiMove, Player::SECOND);
+    reply = game.getExpectedReply();
+    game.playMove(reply == 1 ? 2 : 1, Player::FIRST);
+    aiMove = game.calculateBestMove(Player::SECOND, 8);
+    if (game.getPonderHits() != 1 || !game.isValidMove(aiMove)) {
+        throw runtime_error("Ponder miss not searched again");
+    }
+    cout << "✓ Ponder miss searched normally" << endl;
+    
+    // Timed searches keep pondering for their budget
+    game.playMove(aiMove, Player::SECOND);
+    game.playMove(game.getExpectedReply(), Player::FIRST);
+    aiMove = game.calculateBestMoveTimed(Player::SECOND, 20);
+    game.playMove(aiMove, Player::SECOND);
+    game.playMove(game.getExpectedReply(), Player::FIRST);
+    aiMove = game.calculateBestMoveTimed(Player::SECOND, 20);
+    if (game.getPonderHits() != 2 || !game.isValidMove(aiMove)) {
+        throw runtime_error("Timed ponder hit failed");
+    }
+    cout << "✓ Timed ponder hit" << endl;
+    
+    // Time already pondered counts: past the budget, the move comes at once
+    game.playMove(aiMove, Player::SECOND);
+    game.playMove(game.getExpectedReply(), Player::FIRST);
+    this_thread::sleep_for(chrono::milliseconds(1200));
+    auto start = chrono::steady_clock::now();
+    aiMove = game.calculateBestMoveTimed(Player::SECOND, 1000);
+    auto waited = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+    if (game.getPonderHits() != 3 || !game.isValidMove(aiMove) || waited.count() >= 1000) {
+        throw runtime_error("Timed ponder hit waited for its full budget");
+    }
+    cout << "✓ Budget used up while pondering: answered in " << waited.count() << " ms" << endl;
+    
+    // Hints for the opponent while pondering: the analysis searches the
+    // table beside the ponder search, which still answers the reply
+    Connect4 hinted;
+    hinted.setAIPondering(true);
+    hinted.playMove(4, Player::FIRST);
+    aiMove = hinted.calculateBestMove(Player::SECOND, 10);
+    reply = hinted.getExpectedReply();
+    hinted.playMove(aiMove, Player::SECOND);
+    int32_t scores[BOARD_COLS];
+    uint8_t hint = hinted.analyzeMoves(Player::FIRST, 9, scores);
+    if (!hinted.isValidMove(hint) || scores[reply - 1] == Connect4AI::NO_SCORE) {
+        throw runtime_error("Analysis failed while pondering");
+    }
+    hinted.playMove(reply, Player::FIRST);
+    aiMove = hinted.calculateBestMove(Player::SECOND, 10);
+    if (hinted.getPonderHits() != 1 || !hinted.isValidMove(aiMove)) {
+        throw runtime_error("Ponder search lost during an analysis");
+    }
+    cout << "✓ Analysis while pondering: hint column " << (int)hint << ", ponder hit after it" << endl;
+    
+    cout << "✓ Test 24 passed!\n" << endl;
+}
+
+void testFootprint() {
+    cout << "TEST 25: Memory Footprint" << endl;
+    printSeparator();
+    
+    cout << "  Table " << Connect4Footprint::TABLE << " bytes, game " << Connect4Footprint::GAME
+         << ", stack for " << (int)Connect4Footprint::MAX_PLY << " plies " << Connect4Footprint::STACK << endl;
+    if (Connect4Footprint::TOTAL != Connect4Footprint::TABLE + Connect4Footprint::GAME + Connect4Footprint::STACK ||
+        Connect4Footprint::MAX_PLY > Connect4AI::CELLS) {
+        throw runtime_error("Inconsistent footprint");
+    }
+    
+    // Deeper requests are cut to MAX_PLY, and the measured stack stays
+    // within the per-ply estimate
+    Connect4AI ai;
+    Connect4BitBoard board;
+    Connect4BatchAnalyzer::replay("4153446745253553122", board);
+    ai.calculateBestMove(board, Player::SECOND, 255);
+    const SearchStats& stats = ai.getSearchStats();
+    if (stats.maxDepth > Connect4AI::MAX_PLY) {
+        throw runtime_error("Search deeper than MAX_PLY");
+    }
+#if CONNECT4_SEARCH_STATS
+    if (stats.stackBytes == 0 || stats.stackBytes > (stats.maxDepth + 1u) * CONNECT4_STACK_PER_PLY) {
+        throw runtime_error("Stack use beyond the footprint estimate");
+    }
+    cout << "✓ " << stats.stackBytes << " bytes of stack for " << (int)stats.maxDepth << " plies" << endl;
+#endif
+    
+    cout << "✓ Test 25 passed!\n" << endl;
+}
+
+void testMultiPV() {
+    cout << "TEST 26: Scores of Every Column" << endl;
+    printSeparator();
+    
+    // Without tables, the best column scores like calculateBestMove, and
+    // the others are exact: minimax and PVS agree on all of them
+    const uint8_t depth = 7;
+    Connect4AI ai;
+    Connect4AI reference;
+    ai.setTranspositionTable(nullptr);
+    reference.setTranspositionTable(nullptr);
+    Connect4BitBoard board;
+    Connect4BatchAnalyzer::replay("4453", board);
+    int32_t scores[BOARD_COLS];
+    int8_t best = ai.analyzeMoves(board, Player::FIRST, depth, scores);
+    cout << "  Scores:";
+    for (uint8_t col = 0; col < BOARD_COLS; col++) {
+        cout << " " << scores[col];
+    }
+    cout << endl;
+    reference.calculateBestMove(board, Player::FIRST, depth);
+    if (best < 0 || scores[best] != reference.getLastScore() || ai.getLastScore() != scores[best]) {
+        throw runtime_error("Best column score differs from calculateBestMove");
+    }
+    ai.setSearchAlgorithm(SearchAlgorithm::PVS);
+    int32_t pvsScores[BOARD_COLS];
+    ai.analyzeMoves(board, Player::FIRST, depth, pvsScores);
+    if (memcmp(scores, pvsScores, sizeof(scores)) != 0) {
+        throw runtime_error("PVS column scores differ");
+    }
+    cout << "✓ Column " << (int)best + 1 << " best, same scores with minimax and PVS" << endl;
+    
+    // Lines start with their column and can be played out; the best one is
+    // the principal variation
+    const uint8_t length = 8;
+    int8_t lines[BOARD_COLS * length];
+    ai.setTranspositionTable(&Connect4TranspositionTable::shared());
+    ai.getTranspositionTable()->clear();
+    best = ai.analyzeMoves(board, Player::FIRST, depth, scores, lines, length);
+    for (uint8_t col = 0; col < BOARD_COLS; col++) {
+        const int8_t* line = lines + col * length;
+        Connect4BitBoard position(board);
+        Player player = Player::FIRST;
+        if (line[0] != col) throw runtime_error("Line does not start with its column");
+        for (uint8_t i = 0; i < length && line[i] >= 0; i++) {
+            if (position.isGameOver() || !position.makeMove(static_cast<uint8_t>(line[i]), player)) {
+                throw runtime_error("Line cannot be played");
+            }
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+    }
+    int8_t pv[length];
+    uint8_t pvLength = ai.getPrincipalVariation(pv, length);
+    if (pvLength == 0 || memcmp(pv, lines + best * length, pvLength) != 0) {
+        throw runtime_error("Best line differs from the principal variation");
+    }
+    cout << "✓ " << (int)pvLength << " moves of line for column " << (int)best + 1 << endl;
+    
+    // Mirrored columns of a symmetric position, full columns
+    Connect4BitBoard empty;
+    ai.analyzeMoves(empty, Player::FIRST, 6, scores);
+    for (uint8_t col = 0; col < BOARD_COLS; col++) {
+        if (scores[col] != scores[BOARD_COLS - 1 - col]) throw runtime_error("Mirrored columns differ");
+    }
+    Connect4BitBoard filled;
+    Connect4BatchAnalyzer::replay("444444", filled);
+    ai.analyzeMoves(filled, Player::FIRST, 4, scores);
+    if (scores[3] != Connect4AI::NO_SCORE || scores[2] == Connect4AI::NO_SCORE) {
+        throw runtime_error("Full column scored");
+    }
+    cout << "✓ Symmetric position and full column" << endl;
+    
+    // Solved with perfect play: the best column has the solution's score
+    Connect4BitBoard endgame;
+    Connect4BatchAnalyzer::replay("425646665465425422453325233", endgame);
+    ai.setPerfectPlay(true);
+    best = ai.analyzeMoves(endgame, Player::SECOND, 1, scores);
+    int32_t bestScore = ai.getLastScore();
+    ai.solve(endgame, Player::SECOND);
+    if (best < 0 || bestScore != ai.getLastScore()) {
+        throw runtime_error("Solved column scores differ from solve()");
+    }
+    cout << "✓ Solved scores, best " << bestScore << endl;
+    
+    // Through the game: columns 1-7
+    Connect4 game;
+    game.playMove(4, Player::FIRST);
+    uint8_t gameLines[BOARD_COLS * length];
+    uint8_t column = game.analyzeMoves(Player::SECOND, 6, scores, gameLines, length);
+    if (column < 1 || column > BOARD_COLS || gameLines[(column - 1) * length] != column) {
+        throw runtime_error("Game analysis not in columns 1-7");
+    }
+    cout << "✓ Game analysis suggests column " << (int)column << endl;
+    
+    cout << "✓ Test 26 passed!\n" << endl;
+}
+
+void testEvalWeights() {
+    cout << "TEST 27: Evaluation Weights" << endl;
+    printSeparator();
+    
+    // Other weights: incremental, rescanned and window-by-window scores agree
+    const Connect4EvalWeights weights = {128, 36, 136, 49, 2};
+    uint32_t seed = 4242;
+    for (int gameIndex = 0; gameIndex < 50; gameIndex++) {
+        Connect4BitBoard board;
+        Connect4Evaluator evaluator;
+        evaluator.setWeights(weights);
+        evaluator.reset();
+        Player player = Player::FIRST;
+        while (!board.isGameOver()) {
+            seed = seed * 1103515245 + 12345;
+            uint8_t col = (seed >> 16) % BOARD_COLS;
+            uint8_t row = board.getColumnHeight(col);
+            if (!board.makeMove(col, player)) continue;
+            evaluator.addStone(row, col, player);
+            for (uint8_t p = 1; p <= 2; p++) {
+                Player view = static_cast<Player>(p);
+                int32_t score = Connect4Evaluator::evaluate(board, view, weights);
+                if (evaluator.getScore(view) != score || scanWindows(board, view, weights) != score) {
+                    throw runtime_error("Weighted evaluations differ");
+                }
+            }
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+    }
+    cout << "✓ Weights {128, 36, 136, 49, 2} applied to every window" << endl;
+    
+    // Scores are linear in the weights: doubling them doubles the search
+    // score and keeps the move
+    Connect4EvalWeights doubled = Connect4Evaluator::defaultWeights();
+    doubled.three *= 2;
+    doubled.two *= 2;
+    doubled.opponentThree *= 2;
+    doubled.opponentTwo *= 2;
+    doubled.center *= 2;
+    Connect4AI ai;
+    Connect4AI scaled;
+    ai.setTranspositionTable(nullptr);
+    scaled.setTranspositionTable(nullptr);
+    scaled.setEvalWeights(doubled);
+    Connect4BitBoard board;
+    Connect4BatchAnalyzer::replay("4453", board);
+    int8_t move = ai.calculateBestMove(board, Player::FIRST, 6);
+    if (scaled.calculateBestMove(board, Player::FIRST, 6) != move || scaled.getLastScore() != 2 * ai.getLastScore()) {
+        throw runtime_error("Doubled weights do not double the score");
+    }
+    cout << "✓ Doubled weights: score " << ai.getLastScore() << " -> " << scaled.getLastScore() << endl;
+    
+    // The batch analyzer's workers use the weights it is given
+    Connect4BatchAnalyzer analyzer(2, 6);
+    analyzer.setEvalWeights(weights);
+    ai.setEvalWeights(weights);
+    Connect4AnalysisResult result;
+    analyzer.analyze(&board, 1, &result);
+    ai.calculateBestMove(board, Player::FIRST, 6);
+    if (!result.valid || result.score != ai.getLastScore()) {
+        throw runtime_error("Batch analysis ignores the weights");
+    }
+    cout << "✓ Batch analysis with the same weights scores " << result.score << endl;
+    
+    // Two games sharing the default table, one with doubled weights: each
+    // only reads its own entries, so the scores stay exactly double
+    Connect4 plain;
+    Connect4 tuned;
+    tuned.setAIEvalWeights(doubled);
+    const uint8_t opening[] = {4, 4, 5, 3};
+    for (uint8_t i = 0; i < 4; i++) {
+        plain.playMove(opening[i], i % 2 == 0 ? Player::FIRST : Player::SECOND);
+        tuned.playMove(opening[i], i % 2 == 0 ? Player::FIRST : Player::SECOND);
+    }
+    Connect4TranspositionTable::shared().clear();
+    int32_t plainScores[BOARD_COLS];
+    int32_t tunedScores[BOARD_COLS];
+    for (uint8_t round = 0; round < 2; round++) {
+        plain.analyzeMoves(Player::FIRST, 6, plainScores);
+        tuned.analyzeMoves(Player::FIRST, 6, tunedScores);
+        for (uint8_t col = 0; col < BOARD_COLS; col++) {
+            if (tunedScores[col] != 2 * plainScores[col]) {
+                throw runtime_error("Games with other weights read each other's table entries");
+            }
+        }
+    }
+    cout << "✓ Games with different weights share the table without mixing scores" << endl;
+    
+    cout << "✓ Test 27 passed!\n" << endl;
+}
+
+void testSearchReductions() {
+    cout << "TEST 28: Aspiration Windows and Late Move Reductions" << endl;
+    printSeparator();
+    
+    Connect4AI ai;
+    if (ai.getAspirationWindow() != 0 || ai.getLateMoveReductions()) {
+        throw runtime_error("Aspiration windows or reductions on by default");
+    }
+    ai.setAspirationWindow(-10);
+    if (ai.getAspirationWindow() != 0) {
+        throw runtime_error("Negative aspiration window accepted");
+    }
+    cout << "✓ Both off by default" << endl;
+    
+    // Without a table a search is exact: a narrow window searched again
+    // until the score falls inside finds the full-window score
+    const char* positions[] = {"", "4453", "4153446745253553122", "55534633336744477544553"};
+    Connect4AI wide;
+    ai.setTranspositionTable(nullptr);
+    wide.setTranspositionTable(nullptr);
+    ai.setAspirationWindow(10);
+    for (uint8_t a = 0; a < 2; a++) {
+        SearchAlgorithm algorithm = a == 0 ? SearchAlgorithm::MINIMAX : SearchAlgorithm::PVS;
+        ai.setSearchAlgorithm(algorithm);
+        wide.setSearchAlgorithm(algorithm);
+        for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+            Connect4BitBoard board;
+            Connect4BatchAnalyzer::replay(positions[i], board);
+            Player player = board.getMoveCount() % 2 == 0 ? Player::FIRST : Player::SECOND;
+            int8_t move = ai.calculateBestMove(board, player, 6);
+            wide.calculateBestMove(board, player, 6);
+            if (!board.isValidMove(move) || ai.getLastScore() != wide.getLastScore()) {
+                throw runtime_error("Aspiration windows change the score");
+            }
+        }
+    }
+    cout << "✓ Window of 10: same scores as a full window with minimax and PVS" << endl;
+    
+    // Reductions search fewer nodes and still play a legal move
+    Connect4AI reduced;
+    Connect4AI full;
+    reduced.setLateMoveReductions(true);
+    Connect4BitBoard board;
+    Connect4BatchAnalyzer::replay("4453", board);
+    reduced.getTranspositionTable()->clear();
+    int8_t move = reduced.calculateBestMove(board, Player::FIRST, 10);
+    uint64_t reducedNodes = reduced.getNodeCount();
+    full.getTranspositionTable()->clear();
+    full.calculateBestMove(board, Player::FIRST, 10);
+    if (!board.isValidMove(move) || reducedNodes >= full.getNodeCount()) {
+        throw runtime_error("Late move reductions do not reduce the search");
+    }
+    cout << "✓ Depth 10: " << reducedNodes << " nodes instead of " << full.getNodeCount() << endl;
+#if CONNECT4_SEARCH_STATS
+    const SearchStats& stats = reduced.getSearchStats();
+    if (stats.reducedMoves == 0 || stats.reductionResearches > stats.reducedMoves) {
+        throw runtime_error("Reduction statistics inconsistent");
+    }
+    cout << "✓ " << stats.reducedMoves << " moves reduced, " << stats.reductionResearches << " searched again" << endl;
+#endif
+    
+    // A win is still found through the reductions and windows
+    Connect4 game;
+    game.setAIAspirationWindow(50);
+    game.setAILateMoveReductions(true);
+    for (uint8_t col = 1; col <= 3; col++) {
+        game.playMove(col, Player::FIRST);
+        game.playMove(col, Player::SECOND);
+    }
+    if (game.calculateBestMove(Player::FIRST, 8) != 4) {
+        throw runtime_error("Winning move missed");
+    }
+    cout << "✓ Game settings: winning move found" << endl;
+    
+    cout << "✓ Test 28 passed!\n" << endl;
+}
+
 int main() {
     cout << "\n╔════════════════════════════════════════╗" << endl;
     cout << "║   Connect4 Library Test Suite         ║" << endl;
@@ -243,6 +1639,27 @@ int main() {
         testPerformance();
         testTwoPlayers();
         testFullGame();
+        testBitBoard();
+        testTranspositionTable();
+        testTimedSearch();
+        testParallelSearch();
+        testIncrementalEvaluation();
+        testOpeningBook();
+        testSearchStats();
+        testBatchAnalysis();
+        testThreatDetection();
+        testSearchAlgorithms();
+        testSolver();
+        testBoardGeometry();
+        testSymmetry();
+        testGameRecords();
+        testSessionManager();
+        testResumableSearch();
+        testPondering();
+        testFootprint();
+        testMultiPV();
+        testEvalWeights();
+        testSearchReductions();
         
         printSeparator();
         cout << "✓ ALL TESTS PASSED!" << endl;
@@ -0,0 +1,86 @@
+// Batch position analyzer
+//
+// Reads one position per line on stdin (move string, columns 1-7 starting
+// with Player::FIRST), analyzes them on all cores and writes one line per
+// position on stdout, in input order:
+//
+//   <moves> <best column 1-7> <score>      or      <moves> invalid
+//
+// Usage: connect4_analyze [--depth D] [--threads N] [--batch LINES]
+
+#include "../src/Connect4BatchAnalyzer.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    uint8_t depth = 8;
+    uint8_t threads = 0;
+    size_t batchSize = 65536;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            depth = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchSize = static_cast<size_t>(atol(argv[++i]));
+        } else {
+            cerr << "Usage: " << argv[0] << " [--depth D] [--threads N] [--batch LINES]" << endl;
+            return 1;
+        }
+    }
+    if (batchSize == 0) batchSize = 1;
+
+    ios::sync_with_stdio(false);
+    Connect4BatchAnalyzer analyzer(threads, depth);
+
+    vector<string> lines;
+    vector<const char*> moves;
+    vector<Connect4AnalysisResult> results;
+    size_t total = 0;
+    auto start = chrono::steady_clock::now();
+
+    // Stream in batches so arbitrarily large inputs run in bounded memory
+    string line;
+    bool more = true;
+    while (more) {
+        lines.clear();
+        while (lines.size() < batchSize && (more = static_cast<bool>(getline(cin, line)))) {
+            if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+            lines.push_back(line);
+        }
+        if (lines.empty()) break;
+
+        moves.resize(lines.size());
+        for (size_t i = 0; i < lines.size(); i++) {
+            moves[i] = lines[i].c_str();
+        }
+        results.resize(lines.size());
+        analyzer.analyze(&moves[0], moves.size(), &results[0]);
+
+        for (size_t i = 0; i < lines.size(); i++) {
+            cout << lines[i];
+            if (results[i].valid) {
+                cout << " " << (results[i].bestMove + 1) << " " << results[i].score << "\n";
+            } else {
+                cout << " invalid\n";
+            }
+        }
+        cout.flush();
+        total += lines.size();
+    }
+
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration_cast<chrono::microseconds>(end - start).count() / 1e6;
+    cerr << total << " positions in " << seconds << " s on " << (int)analyzer.getThreads()
+         << " threads (" << (seconds > 0 ? static_cast<uint64_t>(total / seconds) : 0)
+         << " positions/s)" << endl;
+
+    return 0;
+}
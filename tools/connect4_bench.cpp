@@ -0,0 +1,236 @@
+// Search benchmark
+//
+// Searches a fixed suite of opening, midgame and endgame positions at
+// several depths and reports nodes, wall time, nodes per second and best
+// move for each run, plus search statistics, as CSV (default) or JSON, so results can be compared
+// across releases. The transposition table is cleared before every run.
+// With a list of thread counts (--threads 1,2,4,8) the suite runs once per
+// count and the totals give the speedup over the first count.
+// --solve times the exact solve of one position instead ("-" for the empty
+// board), optionally with a larger table (2^bits slots of 16 bytes) and
+// stopping at the positions of a solved opening book.
+//
+// Usage: connect4_bench [--json] [--depths 4,6,8,10] [--threads 1,2,...] [--algorithm minimax|pvs|mtdf]
+//                       [--aspiration W] [--lmr]
+//        connect4_bench [--json] --solve <moves|-> [--table-bits B] [--book book.bin]
+
+#include "../src/Connect4AI.h"
+#include "../src/Connect4OpeningBook.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+using namespace std;
+
+struct BenchPosition {
+    const char* name;
+    const char* moves;  // Columns 1-7, alternating from Player::FIRST
+};
+
+static const BenchPosition SUITE[] = {
+    {"opening-empty", ""},
+    {"opening-center", "4"},
+    {"opening-4", "4453"},
+    {"midgame-19", "4153446745253553122"},
+    {"midgame-23", "55534633336744477544553"},
+    {"endgame-27", "425646665465425422453325233"},
+    {"endgame-29", "42564544532225456452271116666"},
+};
+
+// Replay a move string; returns the side to move
+static Player replay(const char* moves, Connect4BitBoard& board) {
+    Player player = Player::FIRST;
+    for (const char* m = moves; *m; m++) {
+        board.makeMove(static_cast<uint8_t>(*m - '1'), player);
+        player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    }
+    return player;
+}
+
+// Comma-separated values in 1-255 (depths, thread counts)
+static vector<uint8_t> parseList(const char* list) {
+    vector<uint8_t> values;
+    for (const char* p = list; *p; ) {
+        int value = atoi(p);
+        if (value > 0 && value < 256) values.push_back(static_cast<uint8_t>(value));
+        while (*p && *p != ',') p++;
+        if (*p == ',') p++;
+    }
+    return values;
+}
+
+// Exact solve of one position
+static int solvePosition(const char* moves, Connect4TranspositionTable& table, const char* bookPath, bool json) {
+    vector<uint8_t> bytes;
+    Connect4OpeningBook book;
+    Connect4AI ai;
+    table.clear();
+    ai.setTranspositionTable(&table);
+    if (bookPath) {
+        ifstream in(bookPath, ios::binary);
+        bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        if (bytes.empty() || !book.load(&bytes[0], static_cast<uint32_t>(bytes.size()))) {
+            cerr << "Cannot load " << bookPath << endl;
+            return 1;
+        }
+        ai.setOpeningBook(&book);
+    }
+
+    Connect4BitBoard board;
+    Player player = replay(moves, board);
+    auto start = chrono::steady_clock::now();
+    Connect4Solution solution = ai.solve(board, player);
+    auto end = chrono::steady_clock::now();
+
+    double millis = chrono::duration_cast<chrono::microseconds>(end - start).count() / 1000.0;
+    uint64_t nodes = ai.getNodeCount();
+    uint64_t nps = millis > 0 ? static_cast<uint64_t>(nodes * 1000.0 / millis) : 0;
+    if (json) {
+        cout << "{\"moves\": \"" << moves << "\", \"nodes\": " << nodes << ", \"time_ms\": " << millis
+             << ", \"nps\": " << nps << ", \"score\": " << (int)solution.score
+             << ", \"distance\": " << (int)solution.distance << ", \"best_move\": " << (solution.bestMove + 1)
+             << "}" << endl;
+    } else {
+        cout << "moves,nodes,time_ms,nps,score,distance,best_move" << endl;
+        cout << moves << "," << nodes << "," << millis << "," << nps << "," << (int)solution.score << ","
+             << (int)solution.distance << "," << (solution.bestMove + 1) << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    vector<uint8_t> threadCounts(1, 1);
+    SearchAlgorithm algorithm = SearchAlgorithm::MINIMAX;
+    int32_t aspiration = 0;
+    bool lmr = false;
+    const char* solveMoves = nullptr;
+    const char* bookPath = nullptr;
+    uint8_t tableBits = 0;
+    vector<uint8_t> depths = parseList("4,6,8,10");
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--depths") == 0 && i + 1 < argc) {
+            depths = parseList(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCounts = parseList(argv[++i]);
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc && strcmp(argv[i + 1], "minimax") == 0) {
+            algorithm = SearchAlgorithm::MINIMAX;
+            i++;
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc && strcmp(argv[i + 1], "pvs") == 0) {
+            algorithm = SearchAlgorithm::PVS;
+            i++;
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc && strcmp(argv[i + 1], "mtdf") == 0) {
+            algorithm = SearchAlgorithm::MTDF;
+            i++;
+        } else if (strcmp(argv[i], "--aspiration") == 0 && i + 1 < argc) {
+            aspiration = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lmr") == 0) {
+            lmr = true;
+        } else if (strcmp(argv[i], "--solve") == 0 && i + 1 < argc) {
+            solveMoves = strcmp(argv[++i], "-") == 0 ? "" : argv[i];
+        } else if (strcmp(argv[i], "--table-bits") == 0 && i + 1 < argc) {
+            tableBits = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--book") == 0 && i + 1 < argc) {
+            bookPath = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--json] [--depths 4,6,8,10] [--threads 1,2,...] [--algorithm minimax|pvs|mtdf]"
+                 << " [--aspiration W] [--lmr]" << endl;
+            cerr << "       " << argv[0] << " [--json] --solve <moves|-> [--table-bits B] [--book book.bin]" << endl;
+            return 1;
+        }
+    }
+
+    if (solveMoves && tableBits > 0 && tableBits < 32) {
+        vector<Connect4TTSlot> storage(size_t(1) << tableBits);
+        Connect4TranspositionTable table(&storage[0], tableBits);
+        return solvePosition(solveMoves, table, bookPath, json);
+    } else if (solveMoves) {
+        return solvePosition(solveMoves, Connect4TranspositionTable::shared(), bookPath, json);
+    }
+
+    if (threadCounts.empty()) threadCounts.push_back(1);
+
+    Connect4AI ai;
+    ai.setSearchAlgorithm(algorithm);
+    ai.setAspirationWindow(aspiration);
+    ai.setLateMoveReductions(lmr);
+
+    if (json) {
+        cout << "[" << endl;
+    } else {
+        cout << "position,moves,depth,threads,nodes,time_ms,nps,best_move,"
+                "leaf_evaluations,beta_cutoffs,first_move_cutoff_rate,tt_hit_rate,max_depth" << endl;
+    }
+
+    bool first = true;
+    double baseMillis = 0;
+
+    for (size_t t = 0; t < threadCounts.size(); t++) {
+        uint8_t threads = threadCounts[t];
+        ai.setThreads(threads);
+        uint64_t totalNodes = 0;
+        double totalMillis = 0;
+
+        for (size_t p = 0; p < sizeof(SUITE) / sizeof(SUITE[0]); p++) {
+            for (size_t d = 0; d < depths.size(); d++) {
+                Connect4BitBoard board;
+                Player player = replay(SUITE[p].moves, board);
+                ai.getTranspositionTable()->clear();
+
+                auto start = chrono::steady_clock::now();
+                int8_t move = ai.calculateBestMove(board, player, depths[d]);
+                auto end = chrono::steady_clock::now();
+
+                double millis = chrono::duration_cast<chrono::microseconds>(end - start).count() / 1000.0;
+                uint64_t nodes = ai.getNodeCount();
+                const SearchStats& stats = ai.getSearchStats();
+                uint64_t nps = millis > 0 ? static_cast<uint64_t>(nodes * 1000.0 / millis) : 0;
+                totalNodes += nodes;
+                totalMillis += millis;
+
+                if (json) {
+                    cout << (first ? "  " : ",\n  ")
+                         << "{\"position\": \"" << SUITE[p].name << "\", \"moves\": \"" << SUITE[p].moves
+                         << "\", \"depth\": " << (int)depths[d] << ", \"threads\": " << (int)threads
+                         << ", \"nodes\": " << nodes << ", \"time_ms\": " << millis
+                         << ", \"nps\": " << nps << ", \"best_move\": " << (move + 1)
+                         << ", \"leaf_evaluations\": " << stats.leafEvaluations
+                         << ", \"beta_cutoffs\": " << stats.betaCutoffs
+                         << ", \"first_move_cutoff_rate\": " << stats.firstMoveCutoffRate()
+                         << ", \"tt_hit_rate\": " << stats.tableHitRate()
+                         << ", \"max_depth\": " << (int)stats.maxDepth << "}";
+                } else {
+                    cout << SUITE[p].name << "," << SUITE[p].moves << "," << (int)depths[d] << ","
+                         << (int)threads << "," << nodes << "," << millis << "," << nps << ","
+                         << (move + 1) << "," << stats.leafEvaluations << "," << stats.betaCutoffs << ","
+                         << stats.firstMoveCutoffRate() << "," << stats.tableHitRate() << ","
+                         << (int)stats.maxDepth << endl;
+                }
+                first = false;
+            }
+        }
+
+        cerr << "Total: " << totalNodes << " nodes in " << totalMillis << " ms ("
+             << (totalMillis > 0 ? static_cast<uint64_t>(totalNodes * 1000.0 / totalMillis) : 0)
+             << " nodes/s)";
+        if (threadCounts.size() > 1) {
+            if (t == 0) baseMillis = totalMillis;
+            cerr << " with " << (int)threads << " threads, speedup "
+                 << (totalMillis > 0 ? baseMillis / totalMillis : 0);
+        }
+        cerr << endl;
+    }
+
+    if (json) {
+        cout << "\n]" << endl;
+    }
+
+    return 0;
+}
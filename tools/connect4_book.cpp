@@ -0,0 +1,178 @@
+// Opening book generator
+//
+// Enumerates every position reachable by alternating play up to a given ply,
+// searches each one with Connect4AI and writes the best moves as a sorted
+// binary book (see src/Connect4OpeningBook.h), optionally also as a C header
+// holding the same bytes in a PROGMEM array for microcontrollers.
+//
+// With "solve" instead of a search depth, every position is solved and the
+// book also holds its exact score: the solver stops at the book's positions.
+//
+// Usage: connect4_book <max ply> <search depth | solve> <book.bin> [book.h]
+
+#include "../src/Connect4AI.h"
+#include "../src/Connect4OpeningBook.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+// Collect all non-terminal positions up to maxPly, keyed (and sorted) by
+// canonical key: only one of a position and its mirror image is kept
+static void collectPositions(Connect4BitBoard& board, Player player, uint8_t maxPly,
+                             map<uint64_t, Connect4BitBoard>& positions) {
+    if (board.isGameOver() || board.getMoveCount() > maxPly) return;
+    if (!positions.insert(make_pair(board.getCanonicalKey(), board)).second) return;
+
+    Player opponent = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    for (uint8_t col = 0; col < BOARD_COLS; col++) {
+        if (!board.makeMove(col, player)) continue;
+        collectPositions(board, opponent, maxPly, positions);
+        board.undoMove(col);
+    }
+}
+
+// depth 0 for a solved book
+static bool writeHeaderFile(const char* path, const vector<uint8_t>& bytes,
+                            unsigned ply, unsigned depth, size_t count) {
+    ofstream out(path);
+    if (!out) return false;
+
+    out << "// Connect4 opening book generated by tools/connect4_book\n";
+    out << "// Max ply " << ply << ", ";
+    if (depth == 0) {
+        out << "solved";
+    } else {
+        out << "search depth " << depth;
+    }
+    out << ", " << count << " positions\n";
+    out << "#ifndef CONNECT4_BOOK_DATA_H\n#define CONNECT4_BOOK_DATA_H\n\n";
+    out << "#include <stdint.h>\n";
+    out << "#ifdef __AVR__\n#include <avr/pgmspace.h>\n#endif\n";
+    out << "#ifndef PROGMEM\n#define PROGMEM\n#endif\n\n";
+    out << "const uint8_t CONNECT4_BOOK[] PROGMEM = {";
+    for (size_t i = 0; i < bytes.size(); i++) {
+        if (i % 16 == 0) out << "\n   ";
+        out << " " << static_cast<unsigned>(bytes[i]) << ",";
+    }
+    out << "\n};\n\n";
+    out << "const uint32_t CONNECT4_BOOK_SIZE = sizeof(CONNECT4_BOOK);\n\n";
+    out << "#endif // CONNECT4_BOOK_DATA_H\n";
+    return static_cast<bool>(out);
+}
+
+// Best move (and exact score if solved) of each position, of the given ply
+// or of all plies if ply is negative
+static void addRecords(Connect4AI& ai, const map<uint64_t, Connect4BitBoard>& positions, int ply,
+                       bool solved, unsigned depth, map<uint64_t, vector<uint8_t> >& records, size_t& done) {
+    for (map<uint64_t, Connect4BitBoard>::const_iterator it = positions.begin(); it != positions.end(); ++it) {
+        Connect4BitBoard board = it->second;
+        if (ply >= 0 && board.getMoveCount() != ply) continue;
+
+        Player toMove = (board.getMoveCount() % 2 == 0) ? Player::FIRST : Player::SECOND;
+        Connect4Solution solution;
+        int8_t move;
+        if (solved) {
+            solution = ai.solve(board, toMove);
+            move = solution.bestMove;
+        } else {
+            move = ai.calculateBestMove(board, toMove, static_cast<uint8_t>(depth));
+        }
+        if (move < 0) continue;
+        if (board.isMirrored()) move = Connect4BitBoard::mirrorColumn(move);
+
+        vector<uint8_t>& record = records[it->first];
+        if (solved) {
+            record.resize(Connect4OpeningBook::SOLVED_RECORD_SIZE);
+            Connect4OpeningBook::writeSolvedRecord(&record[0], it->first, static_cast<uint8_t>(move), solution.score);
+        } else {
+            record.resize(Connect4OpeningBook::RECORD_SIZE);
+            Connect4OpeningBook::writeRecord(&record[0], it->first, static_cast<uint8_t>(move));
+        }
+
+        if (++done % 100 == 0) {
+            cerr << "\r" << done << "/" << positions.size() << flush;
+        }
+    }
+}
+
+// Book bytes: the header, then the records in key order
+static vector<uint8_t> serialize(const map<uint64_t, vector<uint8_t> >& records, unsigned ply, bool solved) {
+    vector<uint8_t> bytes(Connect4OpeningBook::HEADER_SIZE);
+    Connect4OpeningBook::writeHeader(&bytes[0], static_cast<uint8_t>(ply), BOARD_ROWS, BOARD_COLS, CONNECT_WIN,
+                                     solved);
+    for (map<uint64_t, vector<uint8_t> >::const_iterator it = records.begin(); it != records.end(); ++it) {
+        bytes.insert(bytes.end(), it->second.begin(), it->second.end());
+    }
+    return bytes;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        cerr << "Usage: " << argv[0] << " <max ply> <search depth | solve> <book.bin> [book.h]" << endl;
+        return 1;
+    }
+
+    unsigned ply = static_cast<unsigned>(atoi(argv[1]));
+    bool solved = strcmp(argv[2], "solve") == 0;
+    unsigned depth = solved ? 0 : static_cast<unsigned>(atoi(argv[2]));
+    if (ply >= BOARD_ROWS * BOARD_COLS || (!solved && (depth == 0 || depth > 255))) {
+        cerr << "Invalid ply or depth" << endl;
+        return 1;
+    }
+
+    map<uint64_t, Connect4BitBoard> positions;
+    Connect4BitBoard start;
+    collectPositions(start, Player::FIRST, static_cast<uint8_t>(ply), positions);
+    cerr << positions.size() << " positions up to ply " << ply << endl;
+
+    // Single-threaded search keeps the generated book reproducible
+    Connect4AI ai;
+    map<uint64_t, vector<uint8_t> > records;
+    auto begin = chrono::steady_clock::now();
+    size_t done = 0;
+
+    if (solved) {
+        // From the last ply back, each ply solved with the book of the plies
+        // after it: only the last ply is searched to the end of the game
+        Connect4OpeningBook book;
+        vector<uint8_t> partial;
+        for (int p = static_cast<int>(ply); p >= 0; p--) {
+            addRecords(ai, positions, p, true, depth, records, done);
+            partial = serialize(records, ply, true);
+            book.load(&partial[0], static_cast<uint32_t>(partial.size()));
+            ai.setOpeningBook(&book);
+        }
+        ai.setOpeningBook(nullptr);
+    } else {
+        addRecords(ai, positions, -1, false, depth, records, done);
+    }
+    vector<uint8_t> bytes = serialize(records, ply, solved);
+
+    auto end = chrono::steady_clock::now();
+    cerr << "\r" << done << " positions " << (solved ? "solved" : "searched") << " in "
+         << chrono::duration_cast<chrono::milliseconds>(end - begin).count() << " ms" << endl;
+
+    ofstream out(argv[3], ios::binary);
+    out.write(reinterpret_cast<const char*>(&bytes[0]), bytes.size());
+    if (!out) {
+        cerr << "Cannot write " << argv[3] << endl;
+        return 1;
+    }
+    cerr << "Wrote " << bytes.size() << " bytes to " << argv[3] << endl;
+
+    if (argc > 4) {
+        if (!writeHeaderFile(argv[4], bytes, ply, depth, done)) {
+            cerr << "Cannot write " << argv[4] << endl;
+            return 1;
+        }
+        cerr << "Wrote " << argv[4] << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Memory footprint report
+//
+// Prints the RAM used by the engine as configured by the build flags
+// (CONNECT4_TT_SIZE_BITS, CONNECT4_MAX_PLY, CONNECT4_STACK_PER_PLY, ...),
+// then measures the stack of a few searches to check the per-ply estimate.
+// Build it with the flags of the target to size an embedded build, e.g.
+//   make clean footprint CXXFLAGS="-std=c++11 -O2 -pthread -DCONNECT4_TT_SIZE_BITS=10 -DCONNECT4_MAX_PLY=20"
+//
+// Usage: connect4_footprint [depth]
+
+#include "../src/Connect4Footprint.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+static void replay(const char* moves, Connect4BitBoard& board) {
+    Player player = Player::FIRST;
+    for (const char* m = moves; *m; m++) {
+        board.makeMove(static_cast<uint8_t>(*m - '1'), player);
+        player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    }
+}
+
+int main(int argc, char** argv) {
+    int depth = argc > 1 ? atoi(argv[1]) : 12;
+    if (depth < 1 || depth > Connect4Footprint::MAX_PLY) depth = Connect4Footprint::MAX_PLY < 12 ? Connect4Footprint::MAX_PLY : 12;
+
+    cout << "Build" << endl;
+    cout << "  CONNECT4_TT_SIZE_BITS    " << CONNECT4_TT_SIZE_BITS << endl;
+    cout << "  CONNECT4_MAX_PLY         " << (int)Connect4Footprint::MAX_PLY << endl;
+    cout << "  CONNECT4_STACK_PER_PLY   " << CONNECT4_STACK_PER_PLY << endl;
+    cout << "  CONNECT4_THREADS         " << CONNECT4_THREADS << endl;
+    cout << "  CONNECT4_SEARCH_STATS    " << CONNECT4_SEARCH_STATS << endl;
+    cout << "  CONNECT4_EVAL_BITBOARD   " << CONNECT4_EVAL_BITBOARD << endl;
+
+    cout << "Static footprint (bytes)" << endl;
+    cout << "  Transposition table      " << Connect4Footprint::TABLE << endl;
+    cout << "  Connect4 game            " << Connect4Footprint::GAME << endl;
+    cout << "  Connect4AI               " << Connect4Footprint::AI << endl;
+    cout << "  Connect4Search           " << Connect4Footprint::SEARCH << endl;
+    cout << "  Search stack (estimate)  " << Connect4Footprint::STACK << endl;
+    cout << "  Total                    " << Connect4Footprint::TOTAL << endl;
+
+#if CONNECT4_SEARCH_STATS
+    // Stack measured by the searches, per ply of depth reached
+    const char* algorithms[] = {"minimax", "pvs", "mtdf"};
+    uint32_t worstPerPly = 0;
+    cout << "Measured stack at depth " << depth << " (bytes)" << endl;
+    Connect4AI ai;
+    for (uint8_t a = 0; a < 3; a++) {
+        Connect4BitBoard board;
+        ai.getTranspositionTable()->clear();
+        ai.setSearchAlgorithm(static_cast<SearchAlgorithm>(a));
+        ai.calculateBestMove(board, Player::FIRST, static_cast<uint8_t>(depth));
+        const SearchStats& stats = ai.getSearchStats();
+        uint32_t perPly = stats.maxDepth ? stats.stackBytes / stats.maxDepth : 0;
+        if (perPly > worstPerPly) worstPerPly = perPly;
+        cout << "  " << algorithms[a] << ": " << stats.stackBytes << " for " << (int)stats.maxDepth
+             << " plies (" << perPly << " per ply)" << endl;
+    }
+
+    Connect4BitBoard endgame;
+    replay("425646665465425422453325233", endgame);
+    if (Connect4Footprint::MAX_PLY >= Connect4AI::CELLS - endgame.getMoveCount()) {
+        ai.solve(endgame, Player::SECOND);
+        const SearchStats& stats = ai.getSearchStats();
+        uint32_t perPly = stats.maxDepth ? stats.stackBytes / stats.maxDepth : 0;
+        if (perPly > worstPerPly) worstPerPly = perPly;
+        cout << "  solver: " << stats.stackBytes << " for " << (int)stats.maxDepth
+             << " plies (" << perPly << " per ply)" << endl;
+    }
+
+    if (worstPerPly > CONNECT4_STACK_PER_PLY) {
+        cout << "Warning: CONNECT4_STACK_PER_PLY is below the measured " << worstPerPly << endl;
+        return 1;
+    }
+#else
+    cout << "Stack not measured: build with CONNECT4_SEARCH_STATS" << endl;
+#endif
+    return 0;
+}
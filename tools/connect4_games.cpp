@@ -0,0 +1,130 @@
+// Game record converter
+//
+// Converts games between the text form (one game per line, e.g. "4453 1-0")
+// and the binary record format (see src/Connect4GameRecord.h), or replays a
+// binary file to check every game and measure read throughput.
+//
+// Usage: connect4_games pack   < games.txt > games.c4g
+//        connect4_games unpack < games.c4g > games.txt
+//        connect4_games replay < games.c4g
+
+#include "../src/Connect4BitBoard.h"
+#include "../src/Connect4GameRecord.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const size_t BLOCK_SIZE = 1 << 20;
+
+static int pack() {
+    vector<uint8_t> buffer(BLOCK_SIZE);
+    uint8_t header[Connect4GameRecord::HEADER_SIZE];
+    Connect4GameWriter::writeHeader(header);
+    fwrite(header, 1, sizeof(header), stdout);
+
+    Connect4GameWriter writer(&buffer[0], buffer.size());
+    Connect4GameRecord record;
+    string line;
+    size_t lineNumber = 0;
+    while (getline(cin, line)) {
+        lineNumber++;
+        if (!record.parse(line.c_str())) {
+            cerr << "Line " << lineNumber << ": invalid game" << endl;
+            return 1;
+        }
+        if (!writer.write(record)) {
+            fwrite(writer.getData(), 1, writer.getSize(), stdout);
+            writer.clear();
+            writer.write(record);
+        }
+    }
+    fwrite(writer.getData(), 1, writer.getSize(), stdout);
+    return ferror(stdout) ? 1 : 0;
+}
+
+// Read stdin block by block, calling onRecord for each record
+template <typename OnRecord>
+static bool readRecords(OnRecord onRecord, size_t& bytesRead) {
+    vector<uint8_t> block(BLOCK_SIZE);
+    bytesRead = fread(&block[0], 1, Connect4GameRecord::HEADER_SIZE, stdin);
+    uint8_t rows, cols, win;
+    if (!Connect4GameReader::readHeader(&block[0], bytesRead, rows, cols, win) ||
+        rows != BOARD_ROWS || cols != BOARD_COLS || win != CONNECT_WIN) {
+        cerr << "Not a game record file for the standard board" << endl;
+        return false;
+    }
+
+    Connect4GameReader reader;
+    Connect4GameRecord record;
+    size_t kept = 0;
+    for (;;) {
+        size_t count = fread(&block[kept], 1, block.size() - kept, stdin);
+        bytesRead += count;
+        if (count == 0) break;
+
+        reader.setData(&block[0], kept + count);
+        Connect4ReadStatus status;
+        while ((status = reader.next(record)) == Connect4ReadStatus::OK) {
+            if (!onRecord(record)) return false;
+        }
+        if (status == Connect4ReadStatus::INVALID) {
+            cerr << "Corrupt record at byte " << bytesRead - count - kept + reader.getOffset() << endl;
+            return false;
+        }
+        kept = reader.getRemaining();
+        memmove(&block[0], &block[reader.getOffset()], kept);
+    }
+    if (kept > 0) {
+        cerr << "Truncated last record" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* mode = argc == 2 ? argv[1] : "";
+    if (strcmp(mode, "pack") == 0) {
+        return pack();
+    }
+
+    size_t games = 0;
+    size_t bytes = 0;
+    bool ok;
+    auto start = chrono::steady_clock::now();
+
+    if (strcmp(mode, "unpack") == 0) {
+        char text[Connect4GameRecord::MAX_TEXT_SIZE];
+        ok = readRecords([&](const Connect4GameRecord& record) {
+            record.format(text, sizeof(text));
+            fputs(text, stdout);
+            fputc('\n', stdout);
+            games++;
+            return true;
+        }, bytes);
+    } else if (strcmp(mode, "replay") == 0) {
+        Connect4BitBoard board;
+        ok = readRecords([&](const Connect4GameRecord& record) {
+            if (!record.replay(board)) {
+                cerr << "Game " << games + 1 << ": illegal move or wrong result" << endl;
+                return false;
+            }
+            games++;
+            return true;
+        }, bytes);
+    } else {
+        cerr << "Usage: " << argv[0] << " pack|unpack|replay < input > output" << endl;
+        return 1;
+    }
+
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration_cast<chrono::microseconds>(end - start).count() / 1e6;
+    cerr << games << " games, " << bytes << " bytes in " << seconds << " s ("
+         << (seconds > 0 ? bytes / seconds / 1e6 : 0) << " MB/s, "
+         << (seconds > 0 ? static_cast<uint64_t>(games / seconds) : 0) << " games/s)" << endl;
+    return ok ? 0 : 1;
+}
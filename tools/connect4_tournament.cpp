@@ -0,0 +1,376 @@
+// Self-play tournament
+//
+// Plays engine A against engine B on every core. Games come in pairs on the
+// same random opening, each engine playing FIRST once, so opening luck
+// cancels out. Reports wins/draws/losses of A, the Elo difference with its
+// 95% confidence interval, and the average and maximum move time of each
+// engine. Openings are drawn from --seed, so a run is reproducible for
+// depth-limited engines whatever the number of threads.
+//
+// Engine options, comma-separated: depth=D, time=MS (timed search instead of
+// a fixed depth), algorithm=minimax|pvs|mtdf, perfect (exact solver, only
+// practical from late openings), table=BITS (table size, default 18),
+// weights=T:t:O:o:C (evaluation weights, e.g. from connect4_tune),
+// aspiration=W (aspiration window), lmr (late move reductions).
+//
+// Usage: connect4_tournament --a depth=6 --b depth=8,algorithm=pvs
+//            [--games N] [--threads N] [--openings PLIES] [--seed S] [--save games.txt]
+
+#include "../src/Connect4.h"
+#include "../src/Connect4GameRecord.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct EngineConfig {
+    uint8_t depth;
+    uint32_t millis;   // 0: fixed depth
+    SearchAlgorithm algorithm;
+    bool perfect;
+    uint8_t tableBits;
+    Connect4EvalWeights weights;
+    int32_t aspiration;
+    bool lmr;
+};
+
+// Per engine totals, merged from every worker
+struct EngineTimes {
+    uint64_t moves;
+    double totalMillis;
+    double maxMillis;
+};
+
+struct Totals {
+    uint32_t wins;     // Of engine A
+    uint32_t draws;
+    uint32_t losses;
+    EngineTimes times[2];
+};
+
+// One engine of one worker: its own AI and table
+class Engine {
+public:
+    explicit Engine(const EngineConfig& config)
+        : config(config), storage(static_cast<size_t>(1) << config.tableBits),
+          table(&storage[0], config.tableBits) {
+        ai.setTranspositionTable(&table);
+        ai.setSearchAlgorithm(config.algorithm);
+        ai.setPerfectPlay(config.perfect);
+        ai.setEvalWeights(config.weights);
+        ai.setAspirationWindow(config.aspiration);
+        ai.setLateMoveReductions(config.lmr);
+    }
+
+    // Games do not share table entries, so each game's outcome only depends
+    // on its opening
+    void newGame() {
+        table.clear();
+    }
+
+    // Best column (0-based) for player, timing the search into times
+    int8_t move(const Connect4Board& position, Player player, EngineTimes& times) {
+        Connect4Board board = position;
+        auto start = chrono::steady_clock::now();
+        int8_t column = config.millis > 0 ? ai.calculateBestMoveTimed(board, player, config.millis)
+                                          : ai.calculateBestMove(board, player, config.depth);
+        auto end = chrono::steady_clock::now();
+
+        double millis = chrono::duration_cast<chrono::microseconds>(end - start).count() / 1000.0;
+        times.moves++;
+        times.totalMillis += millis;
+        if (millis > times.maxMillis) times.maxMillis = millis;
+        return column;
+    }
+
+private:
+    EngineConfig config;
+    vector<Connect4TTSlot> storage;
+    Connect4TranspositionTable table;
+    Connect4AI ai;
+};
+
+static bool parseEngine(const char* spec, EngineConfig& config) {
+    config.depth = 6;
+    config.millis = 0;
+    config.algorithm = SearchAlgorithm::MINIMAX;
+    config.perfect = false;
+    config.tableBits = 18;
+    config.weights = Connect4Evaluator::defaultWeights();
+    config.aspiration = 0;
+    config.lmr = false;
+
+    for (const char* p = spec; *p; ) {
+        const char* end = strchr(p, ',');
+        size_t length = end ? static_cast<size_t>(end - p) : strlen(p);
+        string option(p, length);
+
+        if (option.compare(0, 6, "depth=") == 0) {
+            int depth = atoi(option.c_str() + 6);
+            if (depth <= 0 || depth > 42) return false;
+            config.depth = static_cast<uint8_t>(depth);
+        } else if (option.compare(0, 5, "time=") == 0) {
+            config.millis = static_cast<uint32_t>(atol(option.c_str() + 5));
+        } else if (option == "algorithm=minimax") {
+            config.algorithm = SearchAlgorithm::MINIMAX;
+        } else if (option == "algorithm=pvs") {
+            config.algorithm = SearchAlgorithm::PVS;
+        } else if (option == "algorithm=mtdf") {
+            config.algorithm = SearchAlgorithm::MTDF;
+        } else if (option == "perfect") {
+            config.perfect = true;
+        } else if (option.compare(0, 6, "table=") == 0) {
+            int bits = atoi(option.c_str() + 6);
+            if (bits < 4 || bits > 30) return false;
+            config.tableBits = static_cast<uint8_t>(bits);
+        } else if (option.compare(0, 8, "weights=") == 0) {
+            Connect4EvalWeights& w = config.weights;
+            if (sscanf(option.c_str() + 8, "%d:%d:%d:%d:%d", &w.three, &w.two, &w.opponentThree,
+                       &w.opponentTwo, &w.center) != 5) {
+                return false;
+            }
+        } else if (option.compare(0, 11, "aspiration=") == 0) {
+            config.aspiration = atoi(option.c_str() + 11);
+        } else if (option == "lmr") {
+            config.lmr = true;
+        } else {
+            return false;
+        }
+        p += length;
+        if (*p == ',') p++;
+    }
+    return true;
+}
+
+// Random opening of the given length, not already decided: neither side
+// can win on the next move
+static void randomOpening(uint32_t seed, uint8_t plies, Connect4GameRecord& opening) {
+    mt19937 random(seed);
+    Connect4BitBoard board;
+    for (;;) {
+        opening.clear();
+        board.reset();
+        Player player = Player::FIRST;
+        bool decided = false;
+        for (uint8_t i = 0; i < plies && !decided; i++) {
+            uint8_t column;
+            do {
+                column = static_cast<uint8_t>(random() % BOARD_COLS);
+            } while (!board.isValidMove(column));
+            board.makeMove(column, player);
+            opening.addMove(column);
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+            decided = board.isGameOver();
+        }
+        if (!decided && !board.canWinNext(Player::FIRST) && !board.canWinNext(Player::SECOND)) {
+            return;
+        }
+    }
+}
+
+// Play one game from the opening; engines[0] plays FIRST. The record gets
+// the full game.
+static GameState playGame(Engine* engines[2], EngineTimes* times[2], Connect4GameRecord& record) {
+    engines[0]->newGame();
+    engines[1]->newGame();
+
+    Connect4 game;
+    Player player = Player::FIRST;
+    for (uint8_t i = 0; i < record.moveCount; i++) {
+        game.playMove(record.moves[i] + 1, player);
+        player = game.getOpponent(player);
+    }
+
+    while (!game.isGameOver()) {
+        uint8_t side = (player == Player::FIRST) ? 0 : 1;
+        int8_t column = engines[side]->move(game.getBoard(), player, *times[side]);
+        if (column < 0 || !game.playMove(static_cast<uint8_t>(column + 1), player)) {
+            break;  // Cannot happen with a working engine: scored as a loss
+        }
+        record.addMove(static_cast<uint8_t>(column));
+        player = game.getOpponent(player);
+    }
+
+    if (!game.isGameOver()) {
+        record.result = (player == Player::FIRST) ? GameState::SECOND_WINS : GameState::FIRST_WINS;
+    } else {
+        record.result = game.getGameState();
+    }
+    return record.result;
+}
+
+// Elo difference for a score fraction in (0, 1)
+static double eloFromScore(double score) {
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+int main(int argc, char** argv) {
+    EngineConfig configs[2];
+    const char* specs[2] = {"", ""};
+    bool haveEngine[2] = {false, false};
+    uint32_t games = 1000;
+    unsigned threads = 0;
+    uint8_t openingPlies = 4;
+    uint32_t seed = 1;
+    const char* savePath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--a") == 0 || strcmp(argv[i], "--b") == 0) && i + 1 < argc) {
+            int side = argv[i][2] == 'a' ? 0 : 1;
+            if (!parseEngine(argv[++i], configs[side])) {
+                cerr << "Invalid engine: " << argv[i] << endl;
+                return 1;
+            }
+            specs[side] = argv[i];
+            haveEngine[side] = true;
+        } else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            games = static_cast<uint32_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--openings") == 0 && i + 1 < argc) {
+            openingPlies = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else {
+            haveEngine[0] = false;
+            break;
+        }
+    }
+    if (!haveEngine[0] || !haveEngine[1] || games == 0 || openingPlies >= BOARD_ROWS * BOARD_COLS - 2) {
+        cerr << "Usage: " << argv[0] << " --a ENGINE --b ENGINE [--games N] [--threads N]"
+                " [--openings PLIES] [--seed S] [--save games.txt]" << endl;
+        cerr << "ENGINE: depth=D,time=MS,algorithm=minimax|pvs|mtdf,perfect,table=BITS,weights=T:t:O:o:C,"
+                "aspiration=W,lmr" << endl;
+        return 1;
+    }
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+
+    uint32_t pairs = (games + 1) / 2;
+    games = pairs * 2;
+    ofstream save;
+    if (savePath) {
+        save.open(savePath);
+        if (!save) {
+            cerr << "Cannot write " << savePath << endl;
+            return 1;
+        }
+    }
+
+    // Pairs are handed out one at a time: games vary in length, so a static
+    // split would leave cores idle at the end
+    atomic<uint32_t> nextPair(0);
+    atomic<uint32_t> played(0);
+    Totals totals = {};
+    mutex totalsLock;
+    auto start = chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        Engine engineA(configs[0]);
+        Engine engineB(configs[1]);
+        Totals local = {};
+
+        for (uint32_t pair; (pair = nextPair.fetch_add(1)) < pairs; ) {
+            Connect4GameRecord opening;
+            randomOpening(seed * 2654435761u + pair, openingPlies, opening);
+
+            for (uint8_t round = 0; round < 2; round++) {
+                // Round 0: A plays FIRST, round 1: B plays FIRST
+                Engine* engines[2] = {round == 0 ? &engineA : &engineB, round == 0 ? &engineB : &engineA};
+                EngineTimes* times[2] = {&local.times[round], &local.times[1 - round]};
+                Connect4GameRecord record = opening;
+                GameState result = playGame(engines, times, record);
+
+                if (result == GameState::DRAW) {
+                    local.draws++;
+                } else if ((result == GameState::FIRST_WINS) == (round == 0)) {
+                    local.wins++;
+                } else {
+                    local.losses++;
+                }
+                uint32_t done = played.fetch_add(1) + 1;
+                if (savePath || done % 100 == 0) {
+                    lock_guard<mutex> guard(totalsLock);
+                    if (savePath) {
+                        // Games in completion order
+                        char text[Connect4GameRecord::MAX_TEXT_SIZE];
+                        record.format(text, sizeof(text));
+                        save << text << "\n";
+                    }
+                    if (done % 100 == 0) cerr << "\r" << done << "/" << games << flush;
+                }
+            }
+        }
+
+        lock_guard<mutex> guard(totalsLock);
+        totals.wins += local.wins;
+        totals.draws += local.draws;
+        totals.losses += local.losses;
+        for (uint8_t e = 0; e < 2; e++) {
+            totals.times[e].moves += local.times[e].moves;
+            totals.times[e].totalMillis += local.times[e].totalMillis;
+            if (local.times[e].maxMillis > totals.times[e].maxMillis) {
+                totals.times[e].maxMillis = local.times[e].maxMillis;
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (unsigned i = 1; i < threads; i++) {
+        pool.push_back(thread(worker));
+    }
+    worker();
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i].join();
+    }
+
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration_cast<chrono::milliseconds>(end - start).count() / 1000.0;
+    cerr << "\r" << games << " games in " << seconds << " s on " << threads << " threads" << endl;
+
+    // Score of A and its standard error over the per-game scores (1, 1/2, 0)
+    double n = games;
+    double score = (totals.wins + 0.5 * totals.draws) / n;
+    double variance = (totals.wins * (1 - score) * (1 - score) + totals.draws * (0.5 - score) * (0.5 - score) +
+                       totals.losses * score * score) / n;
+    double margin = 1.96 * sqrt(variance / n);
+
+    cout << "A: " << specs[0] << "  B: " << specs[1] << endl;
+    cout << "A wins " << totals.wins << ", draws " << totals.draws
+         << ", losses " << totals.losses << ", score " << score * 100 << "%" << endl;
+    if (score <= 0 || score >= 1) {
+        cout << "Elo difference: " << (score >= 1 ? "+inf" : "-inf") << endl;
+    } else {
+        double low = score - margin > 0 ? eloFromScore(score - margin) : -INFINITY;
+        double high = score + margin < 1 ? eloFromScore(score + margin) : INFINITY;
+        cout << "Elo difference (A - B): " << eloFromScore(score) << "  95% CI [" << low << ", "
+             << high << "]" << endl;
+    }
+    for (uint8_t e = 0; e < 2; e++) {
+        const EngineTimes& t = totals.times[e];
+        cout << (e == 0 ? "A" : "B") << " move time: average "
+             << (t.moves ? t.totalMillis / t.moves : 0) << " ms, max " << t.maxMillis << " ms over "
+             << t.moves << " moves" << endl;
+    }
+
+    if (savePath && !save.flush()) {
+        cerr << "Cannot write " << savePath << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,325 @@
+// Evaluation weight tuner
+//
+// label: draws random positions and solves them on all cores, writing one
+//   position per line with its perfect-play result in the game text form
+//   ("4453 1-0": FIRST wins with perfect play).
+// fit: fits the evaluation weights to labeled positions (Texel tuning).
+//   Every position is scored by a shallow search on all cores
+//   (Connect4BatchAnalyzer), and the weights minimize the mean squared
+//   difference between the result of the side to move (1, 1/2, 0) and
+//   sigmoid(score / K), K being fitted first with the starting weights.
+//   With --games, lines are whole games (e.g. connect4_tournament --save)
+//   and every position before the end gets the game's result.
+//   The weights are printed on stdout as CONNECT4_*_SCORE definitions, to
+//   include before the library or pass with -D (embedded builds), and as a
+//   Connect4EvalWeights for setEvalWeights().
+//
+// Usage: connect4_tune label [--count N] [--plies MIN-MAX] [--seed S] [--threads N] > positions.txt
+//        connect4_tune fit [--depth D] [--threads N] [--games] [--weights T,t,O,o,C]
+//            [--rounds N] < positions.txt > weights.h
+
+#include "../src/Connect4BatchAnalyzer.h"
+#include "../src/Connect4GameRecord.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const uint8_t WEIGHT_COUNT = 5;
+static const char* const WEIGHT_NAMES[WEIGHT_COUNT] = {
+    "CONNECT4_THREE_SCORE", "CONNECT4_TWO_SCORE", "CONNECT4_OPPONENT_THREE_SCORE",
+    "CONNECT4_OPPONENT_TWO_SCORE", "CONNECT4_CENTER_SCORE"};
+
+// Largest weight keeping heuristic scores below forced results (see
+// Connect4EvalWeights)
+static const int32_t MAX_WEIGHT = Connect4Evaluator::WIN_SCORE / (4 * BOARD_ROWS * BOARD_COLS);
+
+static int32_t* weightAt(Connect4EvalWeights& weights, uint8_t i) {
+    int32_t* fields[WEIGHT_COUNT] = {&weights.three, &weights.two, &weights.opponentThree,
+                                     &weights.opponentTwo, &weights.center};
+    return fields[i];
+}
+
+static double elapsedSeconds(chrono::steady_clock::time_point start) {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() / 1000.0;
+}
+
+// Random position after plies moves that is not over and where neither side
+// wins on the next move: its result is not visible to a shallow search
+static void randomPosition(mt19937& random, uint8_t plies, Connect4GameRecord& record, Connect4BitBoard& board) {
+    for (;;) {
+        record.clear();
+        board.reset();
+        Player player = Player::FIRST;
+        for (uint8_t i = 0; i < plies && !board.isGameOver(); i++) {
+            uint8_t column;
+            do {
+                column = static_cast<uint8_t>(random() % BOARD_COLS);
+            } while (!board.isValidMove(column));
+            board.makeMove(column, player);
+            record.addMove(column);
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+        if (!board.isGameOver() && !board.canWinNext(Player::FIRST) && !board.canWinNext(Player::SECOND)) {
+            return;
+        }
+    }
+}
+
+static int label(int argc, char** argv) {
+    uint32_t count = 10000;
+    int minPlies = 16;
+    int maxPlies = 30;
+    uint32_t seed = 1;
+    uint8_t threads = 0;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = static_cast<uint32_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "--plies") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d-%d", &minPlies, &maxPlies) != 2) return -1;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<uint8_t>(atoi(argv[++i]));
+        } else {
+            return -1;
+        }
+    }
+    if (minPlies < 0 || maxPlies < minPlies || maxPlies > BOARD_ROWS * BOARD_COLS - 2) return -1;
+
+    mt19937 random(seed);
+    vector<Connect4GameRecord> records(count);
+    vector<Connect4BitBoard> boards(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t plies = static_cast<uint8_t>(minPlies + random() % (maxPlies - minPlies + 1));
+        randomPosition(random, plies, records[i], boards[i]);
+    }
+
+    // Early positions take the longest to solve: large tables per worker
+    auto start = chrono::steady_clock::now();
+    Connect4BatchAnalyzer solver(threads, 1, 22);
+    solver.setPerfectPlay(true);
+    vector<Connect4AnalysisResult> results(count);
+    solver.analyze(&boards[0], count, &results[0]);
+
+    uint32_t wins[3] = {0, 0, 0};
+    for (uint32_t i = 0; i < count; i++) {
+        Connect4GameRecord& record = records[i];
+        bool firstToMove = record.moveCount % 2 == 0;
+        if (results[i].score > 0) {
+            record.result = firstToMove ? GameState::FIRST_WINS : GameState::SECOND_WINS;
+        } else if (results[i].score < 0) {
+            record.result = firstToMove ? GameState::SECOND_WINS : GameState::FIRST_WINS;
+        } else {
+            record.result = GameState::DRAW;
+        }
+        wins[static_cast<uint8_t>(record.result) - 1]++;
+
+        char text[Connect4GameRecord::MAX_TEXT_SIZE];
+        record.format(text, sizeof(text));
+        cout << text << "\n";
+    }
+    cerr << count << " positions solved in " << elapsedSeconds(start) << " s on " << (int)solver.getThreads()
+         << " threads: " << wins[0] << " 1-0, " << wins[1] << " 0-1, " << wins[2] << " 1/2-1/2" << endl;
+    return 0;
+}
+
+// Positions to fit and the result of their side to move (1, 1/2 or 0)
+struct Dataset {
+    vector<Connect4BitBoard> boards;
+    vector<double> results;
+
+    void add(const Connect4BitBoard& board, GameState result) {
+        if (board.isGameOver()) return;
+        bool firstToMove = board.getMoveCount() % 2 == 0;
+        boards.push_back(board);
+        if (result == GameState::DRAW) {
+            results.push_back(0.5);
+        } else {
+            results.push_back((result == GameState::FIRST_WINS) == firstToMove ? 1.0 : 0.0);
+        }
+    }
+};
+
+static bool readDataset(bool games, Dataset& dataset) {
+    Connect4GameRecord record;
+    string line;
+    size_t lineNumber = 0;
+    while (getline(cin, line)) {
+        lineNumber++;
+        if (!record.parse(line.c_str()) || record.result == GameState::IN_PROGRESS) {
+            cerr << "Line " << lineNumber << ": not a position with a result" << endl;
+            return false;
+        }
+
+        // The result is usually not reached on the board: replay by hand
+        Connect4BitBoard board;
+        Player player = Player::FIRST;
+        for (uint8_t i = 0; i < record.moveCount; i++) {
+            if (games) dataset.add(board, record.result);
+            if (!board.makeMove(record.moves[i], player)) {
+                cerr << "Line " << lineNumber << ": illegal move" << endl;
+                return false;
+            }
+            player = (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+        }
+        if (!games) dataset.add(board, record.result);
+    }
+    return true;
+}
+
+// Scores of the dataset's positions for their side to move
+static void scorePositions(Connect4BatchAnalyzer& analyzer, const Dataset& dataset,
+                           const Connect4EvalWeights& weights, vector<int32_t>& scores) {
+    vector<Connect4AnalysisResult> results(dataset.boards.size());
+    analyzer.setEvalWeights(weights);
+    analyzer.analyze(&dataset.boards[0], dataset.boards.size(), &results[0]);
+    scores.resize(results.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        scores[i] = results[i].score;
+    }
+}
+
+static double meanError(const Dataset& dataset, const vector<int32_t>& scores, double scale) {
+    double total = 0;
+    for (size_t i = 0; i < scores.size(); i++) {
+        double expected = 1.0 / (1.0 + exp(-scores[i] / scale));
+        double error = dataset.results[i] - expected;
+        total += error * error;
+    }
+    return total / scores.size();
+}
+
+// Sigmoid scale that best maps scores to results (golden section search on
+// its logarithm: the error is unimodal in practice)
+static double fitScale(const Dataset& dataset, const vector<int32_t>& scores) {
+    const double ratio = 0.6180339887;
+    double low = log(1.0);
+    double high = log(100000.0);
+    for (uint8_t i = 0; i < 60; i++) {
+        double a = high - ratio * (high - low);
+        double b = low + ratio * (high - low);
+        if (meanError(dataset, scores, exp(a)) < meanError(dataset, scores, exp(b))) {
+            high = b;
+        } else {
+            low = a;
+        }
+    }
+    return exp((low + high) / 2);
+}
+
+static int fit(int argc, char** argv) {
+    uint8_t depth = 1;
+    uint8_t threads = 0;
+    bool games = false;
+    uint32_t maxRounds = 100;
+    Connect4EvalWeights weights = Connect4Evaluator::defaultWeights();
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            depth = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<uint8_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--games") == 0) {
+            games = true;
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            maxRounds = static_cast<uint32_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "--weights") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d,%d,%d,%d,%d", &weights.three, &weights.two, &weights.opponentThree,
+                       &weights.opponentTwo, &weights.center) != WEIGHT_COUNT) {
+                return -1;
+            }
+        } else {
+            return -1;
+        }
+    }
+
+    Dataset dataset;
+    if (!readDataset(games, dataset)) return 1;
+    if (dataset.boards.empty()) {
+        cerr << "No positions" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    Connect4BatchAnalyzer analyzer(threads, depth, 16);
+    vector<int32_t> scores;
+    scorePositions(analyzer, dataset, weights, scores);
+    double scale = fitScale(dataset, scores);
+    double initialError = meanError(dataset, scores, scale);
+    double bestError = initialError;
+    cerr << dataset.boards.size() << " positions, depth " << (int)depth << ", K = " << scale
+         << ", error " << initialError << endl;
+
+    // Coordinate descent: move each weight by its step while the error
+    // drops, halving the steps after a round without progress
+    int32_t steps[WEIGHT_COUNT];
+    for (uint8_t w = 0; w < WEIGHT_COUNT; w++) {
+        int32_t value = *weightAt(weights, w);
+        steps[w] = value > 4 ? value / 4 : 1;
+    }
+    uint32_t evaluations = 1;
+    for (uint32_t round = 1; round <= maxRounds; round++) {
+        bool improved = false;
+        bool moving = false;
+        for (uint8_t w = 0; w < WEIGHT_COUNT; w++) {
+            if (steps[w] == 0) continue;
+            moving = true;
+            int32_t* weight = weightAt(weights, w);
+            int32_t original = *weight;
+            for (int8_t direction = 1; direction >= -1; direction -= 2) {
+                int32_t value = original + direction * steps[w];
+                if (value < 0 || value > MAX_WEIGHT) continue;
+                *weight = value;
+                scorePositions(analyzer, dataset, weights, scores);
+                evaluations++;
+                double error = meanError(dataset, scores, scale);
+                if (error < bestError) {
+                    bestError = error;
+                    improved = true;
+                    break;
+                }
+                *weight = original;
+            }
+            if (*weight == original) steps[w] /= 2;
+        }
+        cerr << "Round " << round << ": error " << bestError << ", weights " << weights.three << ","
+             << weights.two << "," << weights.opponentThree << "," << weights.opponentTwo << ","
+             << weights.center << endl;
+        if (!moving || (!improved && steps[0] + steps[1] + steps[2] + steps[3] + steps[4] == 0)) break;
+    }
+    cerr << evaluations << " passes over the dataset in " << elapsedSeconds(start) << " s" << endl;
+
+    cout << "// Evaluation weights fitted by connect4_tune on " << dataset.boards.size()
+         << " positions (depth " << (int)depth << ", error " << initialError << " -> " << bestError << ")" << endl;
+    for (uint8_t w = 0; w < WEIGHT_COUNT; w++) {
+        cout << "#define " << WEIGHT_NAMES[w] << " " << *weightAt(weights, w) << endl;
+    }
+    cout << "// At run time: Connect4EvalWeights weights = {" << weights.three << ", " << weights.two << ", "
+         << weights.opponentThree << ", " << weights.opponentTwo << ", " << weights.center << "};" << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int status = -1;
+    if (argc >= 2 && strcmp(argv[1], "label") == 0) {
+        status = label(argc, argv);
+    } else if (argc >= 2 && strcmp(argv[1], "fit") == 0) {
+        status = fit(argc, argv);
+    }
+    if (status < 0) {
+        cerr << "Usage: " << argv[0] << " label [--count N] [--plies MIN-MAX] [--seed S] [--threads N]" << endl;
+        cerr << "       " << argv[0] << " fit [--depth D] [--threads N] [--games] [--weights T,t,O,o,C]"
+                " [--rounds N]" << endl;
+        return 1;
+    }
+    return status;
+}